@@ -0,0 +1,209 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "acumuladores.h"
+
+
+/*
+Recorrido de directo (valoresA[ j * D ]) repartiendo la reducción entre K
+acumuladores independientes, o sumando cada bloque de TAM_BLOQUE elementos
+por parejas en árbol antes de añadirlo a la suma. Con un único acumulador
+cada suma depende de la anterior, de modo que en los puntos que caben en la
+L1 el bucle queda limitado por la latencia de addsd y no por la memoria; con
+varios acumuladores (o una suma por bloque) esa dependencia se reparte y se
+mide el rendimiento real del nivel de caché.
+
+Cada K se instancia con su propia función, para que los acumuladores estén
+en registros. Reordenar las sumas cambia el redondeo, por lo que las
+reducciones pueden diferir ligeramente de las de directo.
+*/
+
+
+/* Núcleo de K acumuladores; el acumulador k suma los elementos j con
+   j % K == k, y el resto final se añade al primero */
+#define NUCLEO_ACUMULADORES( nombre, K ) \
+static void nombre( const struct Medida *medida, double *valoresS ) \
+{ \
+    const double *valoresA = medida->valoresA; \
+    long R = medida->R; \
+    long D = medida->D; \
+    \
+    double sumas[ K ]; \
+    double suma; \
+    long j; \
+    int i; \
+    int k; \
+    \
+    \
+    for( i = 0; i < NUM_S; i++ ) \
+    { \
+        _Pragma( "GCC unroll 16" ) \
+        for( k = 0; k < K; k++ ) \
+        { \
+            sumas[ k ] = 0; \
+        } \
+        \
+        for( j = 0; j + K <= R; j += K ) \
+        { \
+            _Pragma( "GCC unroll 16" ) \
+            for( k = 0; k < K; k++ ) \
+            { \
+                sumas[ k ] += valoresA[ ( j + k ) * D ]; \
+            } \
+        } \
+        \
+        for( ; j < R; j++ ) \
+        { \
+            sumas[ 0 ] += valoresA[ j * D ]; \
+        } \
+        \
+        /* Se combinan los acumuladores al terminar */ \
+        suma = 0; \
+        \
+        _Pragma( "GCC unroll 16" ) \
+        for( k = 0; k < K; k++ ) \
+        { \
+            suma += sumas[ k ]; \
+        } \
+        \
+        valoresS[ i ] = suma; \
+    } \
+}
+
+
+NUCLEO_ACUMULADORES( nucleoAcumuladores1, 1 )
+NUCLEO_ACUMULADORES( nucleoAcumuladores2, 2 )
+NUCLEO_ACUMULADORES( nucleoAcumuladores3, 3 )
+NUCLEO_ACUMULADORES( nucleoAcumuladores4, 4 )
+NUCLEO_ACUMULADORES( nucleoAcumuladores5, 5 )
+NUCLEO_ACUMULADORES( nucleoAcumuladores6, 6 )
+NUCLEO_ACUMULADORES( nucleoAcumuladores7, 7 )
+NUCLEO_ACUMULADORES( nucleoAcumuladores8, 8 )
+NUCLEO_ACUMULADORES( nucleoAcumuladores9, 9 )
+NUCLEO_ACUMULADORES( nucleoAcumuladores10, 10 )
+NUCLEO_ACUMULADORES( nucleoAcumuladores11, 11 )
+NUCLEO_ACUMULADORES( nucleoAcumuladores12, 12 )
+NUCLEO_ACUMULADORES( nucleoAcumuladores13, 13 )
+NUCLEO_ACUMULADORES( nucleoAcumuladores14, 14 )
+NUCLEO_ACUMULADORES( nucleoAcumuladores15, 15 )
+NUCLEO_ACUMULADORES( nucleoAcumuladores16, 16 )
+
+
+/* Reducción en árbol por bloques: los TAM_BLOQUE elementos de cada bloque se
+   suman por parejas en log2( TAM_BLOQUE ) niveles independientes entre
+   bloques, y sólo la suma del bloque depende de la iteración anterior */
+static void nucleoArbol( const struct Medida *medida, double *valoresS )
+{
+    const double *valoresA = medida->valoresA;
+    long R = medida->R;
+    long D = medida->D;
+
+    double bloque[ TAM_BLOQUE ];
+    double suma;
+    long j;
+    int ancho;
+    int i;
+    int k;
+
+
+    for( i = 0; i < NUM_S; i++ )
+    {
+        for( j = 0, suma = 0; j + TAM_BLOQUE <= R; j += TAM_BLOQUE )
+        {
+            _Pragma( "GCC unroll 16" )
+            for( k = 0; k < TAM_BLOQUE; k++ )
+            {
+                bloque[ k ] = valoresA[ ( j + k ) * D ];
+            }
+
+            // Cada nivel suma las parejas contiguas del anterior
+            _Pragma( "GCC unroll 4" )
+            for( ancho = TAM_BLOQUE / 2; ancho > 0; ancho /= 2 )
+            {
+                _Pragma( "GCC unroll 16" )
+                for( k = 0; k < ancho; k++ )
+                {
+                    bloque[ k ] = bloque[ 2 * k ] + bloque[ 2 * k + 1 ];
+                }
+            }
+
+            suma += bloque[ 0 ];
+        }
+
+        for( ; j < R; j++ )
+        {
+            suma += valoresA[ j * D ];
+        }
+
+        valoresS[ i ] = suma;
+    }
+}
+
+
+// Núcleo de cada número de acumuladores; la posición ARBOL corresponde a la
+// reducción en árbol
+static void ( * const nucleos[ MAX_ACUMULADORES + 1 ] )(
+    const struct Medida *, double * ) =
+{
+    nucleoArbol, nucleoAcumuladores1, nucleoAcumuladores2,
+    nucleoAcumuladores3, nucleoAcumuladores4, nucleoAcumuladores5,
+    nucleoAcumuladores6, nucleoAcumuladores7, nucleoAcumuladores8,
+    nucleoAcumuladores9, nucleoAcumuladores10, nucleoAcumuladores11,
+    nucleoAcumuladores12, nucleoAcumuladores13, nucleoAcumuladores14,
+    nucleoAcumuladores15, nucleoAcumuladores16
+};
+
+
+int leerAcumuladores( char *texto, int *valores, int maxValores )
+{
+    // Número de valores leídos
+    int numValores;
+
+    char *nombre;
+    char *fin;
+
+
+    // Cada elemento es un número de acumuladores o "arbol"
+    for( numValores = 0, nombre = strtok( texto, "," );
+        nombre != NULL && numValores < maxValores;
+        nombre = strtok( NULL, "," ), numValores++ )
+    {
+        if( strcmp( nombre, "arbol" ) == 0 )
+        {
+            valores[ numValores ] = ARBOL;
+            continue;
+        }
+
+        valores[ numValores ] = ( int )strtol( nombre, &fin, 10 );
+
+        if( *fin != '\0' || valores[ numValores ] < 1 ||
+            valores[ numValores ] > MAX_ACUMULADORES )
+        {
+            printf( "Número de acumuladores incorrecto: %s (de 1 a %d, o "
+                "arbol)\n", nombre, MAX_ACUMULADORES );
+            exit( EXIT_FAILURE );
+        }
+    }
+
+    return( numValores );
+}
+
+
+void describirAcumuladores( int numAcumuladores, char *texto, int tam )
+{
+    if( numAcumuladores == ARBOL )
+    {
+        snprintf( texto, tam, "arbol" );
+    }
+    else
+    {
+        snprintf( texto, tam, "%d", numAcumuladores );
+    }
+}
+
+
+void nucleoAcumuladores( const struct Medida *medida, double *valoresS )
+{
+    nucleos[ medida->numAcumuladores ]( medida, valoresS );
+}
@@ -0,0 +1,22 @@
+#ifndef ACUMULADORES_H
+#define ACUMULADORES_H
+
+#include "modos.h"
+
+
+/* Macros varias */
+
+// Número de acumuladores con el que se indica la reducción en árbol
+#define ARBOL 0
+
+// Elementos de cada bloque de la reducción en árbol (potencia de 2)
+#define TAM_BLOQUE 16
+
+
+/* Prototipos de las funciones a emplear */
+int leerAcumuladores( char *texto, int *valores, int maxValores );
+void describirAcumuladores( int numAcumuladores, char *texto, int tam );
+void nucleoAcumuladores( const struct Medida *medida, double *valoresS );
+
+
+#endif
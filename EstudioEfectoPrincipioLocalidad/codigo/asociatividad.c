@@ -0,0 +1,60 @@
+#include "asociatividad.h"
+
+
+/*
+Explorador de conflictos en los conjuntos: K líneas separadas exactamente el
+tamaño de una vía de un nivel (número de conjuntos por tamaño de línea)
+caen todas en el mismo conjunto de ese nivel. Mientras K no supere su
+asociatividad, las K líneas caben a la vez; a partir de ahí cada acceso
+falla y debe servirse del siguiente nivel, por lo que la latencia de la
+cadena que las recorre da un salto (el codo). Como el paso es también
+múltiplo del tamaño de vía de los niveles inferiores, las líneas ya
+conflictan en ellos, y el codo de cada nivel se busca a partir del anterior.
+
+En los niveles indexados físicamente el paso sólo se respeta dentro de una
+página, por lo que conviene medir con páginas enormes (-a thp o hugetlb); y
+las L3 que reparten las líneas entre porciones con una función hash pueden
+no mostrar codo alguno.
+*/
+
+
+void construirConjunto( void **base, int K, size_t paso )
+{
+    // Contador
+    int k;
+
+
+    // Se enlaza cada línea con la siguiente, cerrando el ciclo en la primera;
+    // el paso supera la página, por lo que la precarga no lo sigue
+    for( k = 0; k < K; k++ )
+    {
+        *( void ** )( ( char * )base + k * paso ) =
+            ( char * )base + ( ( k + 1 ) % K ) * paso;
+    }
+}
+
+
+int buscarCodo( const double *ciclos, int numK, int inicio )
+{
+    // Contador
+    int k;
+
+
+    // ciclos[ k ] corresponde a K = k + 1; se toma como referencia la
+    // latencia en K = inicio, la primera en la que el nivel ya sirve los
+    // accesos, y se busca el primer K que la supera claramente
+    if( inicio < 1 || inicio > numK )
+    {
+        return( 0 );
+    }
+
+    for( k = inicio; k < numK; k++ )
+    {
+        if( ciclos[ k ] > UMBRAL_CODO * ciclos[ inicio - 1 ] )
+        {
+            return( k + 1 );
+        }
+    }
+
+    return( 0 );
+}
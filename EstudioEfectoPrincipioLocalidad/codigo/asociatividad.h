@@ -0,0 +1,24 @@
+#ifndef ASOCIATIVIDAD_H
+#define ASOCIATIVIDAD_H
+
+#include <stddef.h>
+
+
+/* Macros varias */
+
+// Saltos de la cadena por repetición, independientemente de K
+#define ACCESOS_CONJUNTO 100000
+
+// Máximo de líneas en conflicto (el doble de la asociatividad)
+#define MAX_K 128
+
+// Incremento relativo de los ciclos por acceso que se considera un codo
+#define UMBRAL_CODO 1.5
+
+
+/* Prototipos de las funciones a emplear */
+void construirConjunto( void **base, int K, size_t paso );
+int buscarCodo( const double *ciclos, int numK, int inicio );
+
+
+#endif
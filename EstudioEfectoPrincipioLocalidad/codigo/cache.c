@@ -0,0 +1,328 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <cpuid.h>
+#include <immintrin.h>
+
+#include "cache.h"
+
+
+/*
+Valores por defecto, correspondientes al equipo de pruebas original (Haswell),
+empleados si no se puede consultar la jerarquía de cachés:
+
+  - L1 de datos: 32 K, 8 vías, líneas de 64 bytes, 64 conjuntos
+  - L2 unificada: 256 K, 4 vías, líneas de 64 bytes, 1024 conjuntos
+  - L3 unificada: 3072 K, 12 vías, líneas de 64 bytes, 4096 conjuntos
+*/
+static const struct NivelCache nivelesPorDefecto[] =
+{
+    { 1, 32 * 1024, 8, 64, 64 },
+    { 2, 256 * 1024, 4, 64, 1024 },
+    { 3, 3072 * 1024, 12, 64, 4096 }
+};
+
+#define SYSFS_CACHE "/sys/devices/system/cpu/cpu0/cache"
+
+
+/* Lee el primer entero de un fichero de sysfs; admite los sufijos K y M
+   empleados en "size". Devuelve -1 si no es posible */
+static long leerValorSysfs( const char *directorio, const char *fichero )
+{
+    char ruta[ 320 ];
+    char sufijo;
+    long valor;
+    FILE *f;
+
+
+    snprintf( ruta, sizeof( ruta ), "%s/%s", directorio, fichero );
+
+    if( ( f = fopen( ruta, "r" ) ) == NULL )
+    {
+        return( -1 );
+    }
+
+    sufijo = '\0';
+
+    if( fscanf( f, "%ld%c", &valor, &sufijo ) < 1 )
+    {
+        valor = -1;
+    }
+
+    else if( sufijo == 'K' )
+    {
+        valor *= 1024;
+    }
+
+    else if( sufijo == 'M' )
+    {
+        valor *= 1024 * 1024;
+    }
+
+    fclose( f );
+
+    return( valor );
+}
+
+
+/* Inserta un nivel manteniendo el orden, descartando niveles repetidos */
+static void anadirNivel( struct GeometriaCache *geometria, const struct
+    NivelCache *nivel )
+{
+    int i;
+
+
+    if( geometria->numNiveles == MAX_NIVELES_CACHE || nivel->tam <= 0 ||
+        nivel->tamLinea <= 0 )
+    {
+        return;
+    }
+
+    for( i = geometria->numNiveles; i > 0 &&
+        geometria->niveles[ i - 1 ].nivel >= nivel->nivel; i-- )
+    {
+        if( geometria->niveles[ i - 1 ].nivel == nivel->nivel )
+        {
+            return;
+        }
+    }
+
+    memmove( &geometria->niveles[ i + 1 ], &geometria->niveles[ i ],
+        ( geometria->numNiveles - i ) * sizeof( struct NivelCache ) );
+    geometria->niveles[ i ] = *nivel;
+    geometria->numNiveles++;
+}
+
+
+static int detectarSysfs( struct GeometriaCache *geometria )
+{
+    char directorio[ 256 ];
+    char ruta[ 320 ];
+    char tipo[ 32 ];
+    struct NivelCache nivel;
+    FILE *f;
+    int i;
+
+
+    for( i = 0; ; i++ )
+    {
+        snprintf( directorio, sizeof( directorio ), "%s/index%d", SYSFS_CACHE,
+            i );
+        snprintf( ruta, sizeof( ruta ), "%s/type", directorio );
+
+        if( ( f = fopen( ruta, "r" ) ) == NULL )
+        {
+            break;
+        }
+
+        if( fscanf( f, "%31s", tipo ) != 1 )
+        {
+            tipo[ 0 ] = '\0';
+        }
+
+        fclose( f );
+
+        // Se descartan las cachés de instrucciones
+        if( strcmp( tipo, "Data" ) != 0 && strcmp( tipo, "Unified" ) != 0 )
+        {
+            continue;
+        }
+
+        nivel.nivel = leerValorSysfs( directorio, "level" );
+        nivel.tam = leerValorSysfs( directorio, "size" );
+        nivel.vias = leerValorSysfs( directorio, "ways_of_associativity" );
+        nivel.tamLinea = leerValorSysfs( directorio, "coherency_line_size" );
+        nivel.conjuntos = leerValorSysfs( directorio, "number_of_sets" );
+
+        anadirNivel( geometria, &nivel );
+    }
+
+    return( geometria->numNiveles );
+}
+
+
+/* Recorre las subhojas de la hoja de CPUID indicada (4 en Intel, 0x8000001D
+   en AMD, ambas con el mismo formato) */
+static int detectarCpuid( struct GeometriaCache *geometria, unsigned hoja )
+{
+    unsigned eax, ebx, ecx, edx;
+    unsigned tipo;
+    unsigned particiones;
+    struct NivelCache nivel;
+    unsigned i;
+
+
+    if( __get_cpuid_max( hoja & 0x80000000, NULL ) < hoja )
+    {
+        return( 0 );
+    }
+
+    for( i = 0; ; i++ )
+    {
+        __cpuid_count( hoja, i, eax, ebx, ecx, edx );
+
+        // Tipo 0: no hay más cachés
+        if( ( tipo = eax & 0x1F ) == 0 )
+        {
+            break;
+        }
+
+        // Tipo 2: caché de instrucciones
+        if( tipo == 2 )
+        {
+            continue;
+        }
+
+        nivel.nivel = ( eax >> 5 ) & 0x7;
+        nivel.tamLinea = ( ebx & 0xFFF ) + 1;
+        particiones = ( ( ebx >> 12 ) & 0x3FF ) + 1;
+        nivel.vias = ( ( ebx >> 22 ) & 0x3FF ) + 1;
+        nivel.conjuntos = ecx + 1;
+        nivel.tam = ( long )nivel.vias * particiones * nivel.tamLinea *
+            nivel.conjuntos;
+
+        anadirNivel( geometria, &nivel );
+    }
+
+    return( geometria->numNiveles );
+}
+
+
+void detectarCache( struct GeometriaCache *geometria )
+{
+    // Contador
+    int i;
+
+
+    geometria->numNiveles = 0;
+    geometria->origen = "sysfs";
+
+    // Se consulta en primer lugar sysfs, y en su defecto CPUID
+    if( detectarSysfs( geometria ) == 0 )
+    {
+        geometria->origen = "cpuid";
+
+        if( detectarCpuid( geometria, 4 ) == 0 )
+        {
+            detectarCpuid( geometria, 0x8000001D );
+        }
+    }
+
+    // Si nada de lo anterior ha funcionado, se emplea el equipo original
+    if( geometria->numNiveles == 0 )
+    {
+        geometria->origen = "por defecto";
+
+        for( i = 0; i < ( int )( sizeof( nivelesPorDefecto ) /
+            sizeof( nivelesPorDefecto[ 0 ] ) ); i++ )
+        {
+            anadirNivel( geometria, &nivelesPorDefecto[ i ] );
+        }
+    }
+
+    geometria->tamLinea = geometria->niveles[ 0 ].tamLinea;
+}
+
+
+static int compararEnteros( const void *a, const void *b )
+{
+    return( *( const int * )a - *( const int * )b );
+}
+
+
+int calcularValoresL( const struct GeometriaCache *geometria, int *valoresL )
+{
+    // Número de líneas que caben en el nivel iterado
+    int S = 0;
+
+    int numValores;
+    int i;
+    int j;
+
+
+    // Se toman, para cada nivel, un punto que cabe holgadamente en él (la
+    // mitad de su capacidad) y otro que la supera (1.5 veces), de modo
+    // análogo a los S1 / 2, 3 * S1 / 2 de los programas originales
+    for( i = 0, numValores = 0; i < geometria->numNiveles; i++ )
+    {
+        S = geometria->niveles[ i ].tam / geometria->tamLinea;
+
+        valoresL[ numValores++ ] = S / 2;
+        valoresL[ numValores++ ] = 3 * S / 2;
+    }
+
+    // Y un último punto que sólo puede servirse desde memoria principal
+    valoresL[ numValores++ ] = 2 * S;
+
+    // Se ordenan y se eliminan los valores repetidos que pueden surgir con
+    // niveles de tamaños próximos
+    qsort( valoresL, numValores, sizeof( int ), compararEnteros );
+
+    for( i = 1, j = 1; i < numValores; i++ )
+    {
+        if( valoresL[ i ] != valoresL[ j - 1 ] )
+        {
+            valoresL[ j++ ] = valoresL[ i ];
+        }
+    }
+
+    return( j );
+}
+
+
+void imprimirCache( const struct GeometriaCache *geometria, FILE *salida )
+{
+    int i;
+
+
+    fprintf( salida, "Cachés de datos (%s):\n", geometria->origen );
+
+    for( i = 0; i < geometria->numNiveles; i++ )
+    {
+        fprintf( salida, "  - L%d: %ld K, %d vías, líneas de %d bytes, %d "
+            "conjuntos\n", geometria->niveles[ i ].nivel,
+            geometria->niveles[ i ].tam / 1024, geometria->niveles[ i ].vias,
+            geometria->niveles[ i ].tamLinea,
+            geometria->niveles[ i ].conjuntos );
+    }
+}
+
+
+__attribute__(( target( "clflushopt" ) ))
+static void vaciarLineasOpt( const char *inicio, const char *fin,
+    int tamLinea )
+{
+    // clflushopt no se ordena con los demás vaciados, por lo que las líneas
+    // se expulsan en paralelo
+    for( ; inicio < fin; inicio += tamLinea )
+    {
+        _mm_clflushopt( ( void * )inicio );
+    }
+}
+
+
+void vaciarCache( const void *bloque, size_t bytes, int tamLinea )
+{
+    // Se parte del comienzo de la línea que contiene el bloque
+    const char *inicio = ( const char * )( ( size_t )bloque &
+        ~( size_t )( tamLinea - 1 ) );
+    const char *fin = ( const char * )bloque + bytes;
+
+
+    // Se expulsa cada línea del bloque de todos los niveles de caché,
+    // escribiéndola en memoria si estaba modificada
+    if( __builtin_cpu_supports( "clflushopt" ) )
+    {
+        vaciarLineasOpt( inicio, fin, tamLinea );
+    }
+    else
+    {
+        for( ; inicio < fin; inicio += tamLinea )
+        {
+            _mm_clflush( inicio );
+        }
+    }
+
+    // Se espera a que terminen todos los vaciados antes de seguir
+    _mm_mfence();
+}
@@ -0,0 +1,48 @@
+#ifndef CACHE_H
+#define CACHE_H
+
+#include <stddef.h>
+#include <stdio.h>
+
+
+/* Macros varias */
+#define MAX_NIVELES_CACHE 4
+#define MAX_VALORES_L ( 2 * MAX_NIVELES_CACHE + 1 )
+
+
+/* Características de un nivel de caché de datos (o unificada) */
+struct NivelCache
+{
+    int nivel;
+
+    // Tamaño total en bytes
+    long tam;
+
+    int vias;
+    int tamLinea;
+    int conjuntos;
+};
+
+
+/* Jerarquía de cachés de datos vista por un core, ordenada por nivel */
+struct GeometriaCache
+{
+    int numNiveles;
+    struct NivelCache niveles[ MAX_NIVELES_CACHE ];
+
+    // Tamaño de línea de la L1 de datos, empleado para alinear las reservas
+    int tamLinea;
+
+    // Origen de los datos: "sysfs", "cpuid" o "por defecto"
+    const char *origen;
+};
+
+
+/* Prototipos de las funciones a emplear */
+void detectarCache( struct GeometriaCache *geometria );
+int calcularValoresL( const struct GeometriaCache *geometria, int *valoresL );
+void imprimirCache( const struct GeometriaCache *geometria, FILE *salida );
+void vaciarCache( const void *bloque, size_t bytes, int tamLinea );
+
+
+#endif
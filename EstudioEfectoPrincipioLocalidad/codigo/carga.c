@@ -0,0 +1,231 @@
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sched.h>
+#include <immintrin.h>
+
+#include "carga.h"
+#include "contador.h"
+#include "memoria.h"
+
+
+/*
+Latencia con carga: mientras el hilo principal recorre la cadena de punteros
+de latencia, otros N - 1 cores leen cada uno su propio vector de principio a
+fin, línea a línea, ocupando el ancho de banda compartido de la L3 y de la
+memoria. Cada generador recorre TRAMO_CARGA bytes y después espera lo
+necesario para que el recorrido ocupe el porcentaje de tiempo indicado por la
+intensidad, de modo que se obtiene la curva de latencia frente al ancho de
+banda consumido por el resto del sistema.
+
+Los generadores son hilos POSIX y no una región paralela de OpenMP, ya que
+deben seguir ejecutándose mientras el hilo principal realiza la medida
+completa. El hilo principal no se mueve de su core; los generadores se fijan
+a los siguientes.
+*/
+
+
+int leerIntensidades( char *texto, int *valores, int maxValores )
+{
+    // Número de valores leídos
+    int numValores;
+
+    char *valor;
+    char *fin;
+
+
+    for( numValores = 0, valor = strtok( texto, "," );
+        valor != NULL && numValores < maxValores;
+        valor = strtok( NULL, "," ), numValores++ )
+    {
+        valores[ numValores ] = ( int )strtol( valor, &fin, 10 );
+
+        if( *fin != '\0' || valores[ numValores ] < 1 ||
+            valores[ numValores ] > 100 )
+        {
+            printf( "Intensidad incorrecta: %s (de 1 a 100 %%)\n", valor );
+            exit( EXIT_FAILURE );
+        }
+    }
+
+    return( numValores );
+}
+
+
+/* Cuerpo de cada generador */
+static void *generar( void *argumento )
+{
+    struct Generador *generador = argumento;
+
+    const double *vector;
+    const double *fin;
+    const double *elemento;
+
+    // Instantes de comienzo del recorrido, de cada tramo y de su final
+    unsigned long long comienzo;
+    unsigned long long inicio;
+    unsigned long long final;
+
+    double suma;
+    size_t recorridos;
+    long doublesLinea;
+    cpu_set_t afinidad;
+
+
+    CPU_ZERO( &afinidad );
+    CPU_SET( generador->core, &afinidad );
+    sched_setaffinity( 0, sizeof( cpu_set_t ), &afinidad );
+
+    // El propio generador reserva y escribe su vector, de modo que quede en
+    // su nodo de memoria
+    if( ( vector = reservarBloque( generador->memoria, generador->bytes,
+        generador->alineamiento ) ) == NULL )
+    {
+        perror( "Reserva de memoria fallida" );
+        exit( EXIT_FAILURE );
+    }
+
+    memset( ( void * )vector, 0, generador->bytes );
+
+    doublesLinea = generador->tamLinea / sizeof( double );
+    fin = vector + generador->bytes / sizeof( double );
+    elemento = vector;
+    suma = 0;
+    generador->leidos = 0;
+
+    __sync_fetch_and_add( generador->listos, 1 );
+    comienzo = leerCiclos();
+
+    while( !*generador->parar )
+    {
+        inicio = leerCiclos();
+
+        // Se lee un double de cada línea del tramo
+        for( recorridos = 0; recorridos < TRAMO_CARGA;
+            recorridos += generador->tamLinea )
+        {
+            suma += *elemento;
+            elemento += doublesLinea;
+
+            if( elemento >= fin )
+            {
+                elemento = vector;
+            }
+        }
+
+        generador->leidos += TRAMO_CARGA;
+
+        // Y se espera hasta que el tramo ocupe la fracción de tiempo pedida
+        final = leerCiclos();
+        final += ( final - inicio ) * ( 100 - generador->intensidad ) /
+            generador->intensidad;
+
+        while( leerCiclos() < final && !*generador->parar )
+        {
+            _mm_pause();
+        }
+    }
+
+    generador->ciclos = leerCiclos() - comienzo;
+    consumir( suma );
+
+    liberarBloque( generador->memoria, ( void * )vector, generador->bytes );
+
+    return( NULL );
+}
+
+
+void iniciarCarga( struct Carga *carga, int numGeneradores, int intensidad,
+    int memoria, size_t bytes, size_t alineamiento, int tamLinea )
+{
+    struct Generador *generador;
+
+    // Core del hilo principal
+    int propio;
+    cpu_set_t afinidad;
+
+    // Cores permitidos al proceso distintos del principal, a los que se
+    // fijan los generadores
+    int cores[ MAX_HILOS ];
+    int numCores;
+
+    int i;
+    int j;
+
+
+    carga->numGeneradores = numGeneradores;
+    carga->listos = 0;
+    carga->parar = 0;
+
+    // Se fija el hilo principal a su core actual, para que no coincida con
+    // ningún generador
+    propio = sched_getcpu();
+    numCores = coresPermitidos( cores );
+
+    for( i = 0, j = 0; i < numCores; i++ )
+    {
+        if( cores[ i ] != propio )
+        {
+            cores[ j++ ] = cores[ i ];
+        }
+    }
+
+    // Con un solo core permitido los generadores lo comparten con el
+    // principal
+    numCores = j > 0 ? j : numCores;
+
+    sched_getaffinity( 0, sizeof( cpu_set_t ), &carga->afinidadOriginal );
+    CPU_ZERO( &afinidad );
+    CPU_SET( propio, &afinidad );
+    sched_setaffinity( 0, sizeof( cpu_set_t ), &afinidad );
+
+    for( i = 0; i < numGeneradores; i++ )
+    {
+        generador = &carga->generadores[ i ];
+        generador->core = cores[ i % numCores ];
+        generador->memoria = memoria;
+        generador->bytes = bytes;
+        generador->alineamiento = alineamiento;
+        generador->tamLinea = tamLinea;
+        generador->intensidad = intensidad;
+        generador->listos = &carga->listos;
+        generador->parar = &carga->parar;
+
+        if( pthread_create( &generador->hilo, NULL, generar, generador ) != 0 )
+        {
+            perror( "Creación del generador de carga fallida" );
+            exit( EXIT_FAILURE );
+        }
+    }
+
+    // Se espera a que todos estén recorriendo su vector
+    while( carga->listos < numGeneradores )
+    {
+        _mm_pause();
+    }
+}
+
+
+double detenerCarga( struct Carga *carga, double frecuencia )
+{
+    // Ancho de banda de todos los generadores, en GB/s
+    double total;
+    int i;
+
+
+    carga->parar = 1;
+
+    for( i = 0, total = 0; i < carga->numGeneradores; i++ )
+    {
+        pthread_join( carga->generadores[ i ].hilo, NULL );
+
+        // Los ciclos se convierten a segundos con la frecuencia en MHz
+        total += carga->generadores[ i ].leidos / ( 1e3 *
+            carga->generadores[ i ].ciclos / frecuencia );
+    }
+
+    sched_setaffinity( 0, sizeof( cpu_set_t ), &carga->afinidadOriginal );
+
+    return( total );
+}
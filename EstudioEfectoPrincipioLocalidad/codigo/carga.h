@@ -0,0 +1,71 @@
+#ifndef CARGA_H
+#define CARGA_H
+
+#include <pthread.h>
+#include <sched.h>
+#include <stddef.h>
+
+#include "hilos.h"
+
+
+/* Macros varias */
+
+// Máximo de intensidades de la carga de fondo
+#define MAX_INTENSIDADES 8
+
+// Bytes que recorre cada generador entre pausas
+#define TRAMO_CARGA ( 256 * 1024 )
+
+// Mínimo de bytes del vector de cada generador, para que su tráfico salga
+// de las cachés privadas aunque la última caché detectada sea la de un solo
+// CCX o porción
+#define MIN_VECTOR_CARGA ( 8 * 1024 * 1024 )
+
+
+/* Hilo que recorre su propio vector para generar tráfico de fondo */
+struct Generador
+{
+    pthread_t hilo;
+    int core;
+
+    // Forma de reservar el vector, sus bytes y tamaño de línea
+    int memoria;
+    size_t bytes;
+    size_t alineamiento;
+    int tamLinea;
+
+    // Porcentaje del tiempo que el generador pasa recorriendo el vector
+    int intensidad;
+
+    // Bytes leídos y ciclos transcurridos desde que empezó a recorrerlo
+    double leidos;
+    unsigned long long ciclos;
+
+    // Indicadores compartidos de arranque y parada
+    volatile int *listos;
+    volatile int *parar;
+};
+
+
+/* Carga de fondo de varios generadores */
+struct Carga
+{
+    struct Generador generadores[ MAX_HILOS ];
+    int numGeneradores;
+
+    volatile int listos;
+    volatile int parar;
+
+    // Afinidad del hilo principal, que se restaura al detener la carga
+    cpu_set_t afinidadOriginal;
+};
+
+
+/* Prototipos de las funciones a emplear */
+int leerIntensidades( char *texto, int *valores, int maxValores );
+void iniciarCarga( struct Carga *carga, int numGeneradores, int intensidad,
+    int memoria, size_t bytes, size_t alineamiento, int tamLinea );
+double detenerCarga( struct Carga *carga, double frecuencia );
+
+
+#endif
@@ -0,0 +1,425 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <immintrin.h>
+
+#include "compresion.h"
+#include "memoria.h"
+
+
+/*
+Flujos de índices comprimidos para el bucle de junto.c. Con D pequeño cada
+acceso de 8 bytes a A requiere 4 bytes de e[], de modo que el flujo de
+índices consume buena parte del ancho de banda; aquí se guardan las
+diferencias entre índices consecutivos en 16 u 8 bits (con escapes de 32
+bits para las que no caben), o las rachas de diferencias iguales.
+
+La decodificación se realiza dentro del propio bucle de la reducción, sin
+descomprimir antes: las diferencias se cargan de 8 en 8, se extienden a 32
+bits y se acumulan con una suma prefija AVX2, y los 8 índices obtenidos se
+usan directamente para leer A. Las rachas generan sus índices sumando 8
+veces la diferencia a un vector. La suma es escalar y con un único
+acumulador, como en junto, para que sólo cambie el coste de los índices.
+*/
+
+
+const char *nombresCodificaciones[ NUM_CODIFICACIONES ] =
+{
+    [ CODIFICACION_PLANA ] = "plano",
+    [ CODIFICACION_DELTA16 ] = "delta16",
+    [ CODIFICACION_DELTA8 ] = "delta8",
+    [ CODIFICACION_RLE ] = "rle"
+};
+
+const char *nombresFuentes[ NUM_FUENTES ] =
+{
+    [ FUENTE_JUNTO ] = "junto",
+    [ FUENTE_ENTORNO ] = "entorno",
+    [ FUENTE_PAGINA ] = "pagina"
+};
+
+
+int buscarCodificacion( const char *nombre )
+{
+    // Contador
+    int i;
+
+
+    for( i = 0; i < NUM_CODIFICACIONES; i++ )
+    {
+        if( strcmp( nombresCodificaciones[ i ], nombre ) == 0 )
+        {
+            return( i );
+        }
+    }
+
+    return( -1 );
+}
+
+
+int comprimirIndices( const int *e, long R, int codificacion, int memoria,
+    size_t alineamiento, struct IndicesComprimidos *comprimidos )
+{
+    short *deltas16;
+    signed char *deltas8;
+    struct Racha *rachas;
+
+    // Diferencia con el índice anterior
+    long delta;
+
+    // Contador
+    long j;
+
+
+    memset( comprimidos, 0, sizeof( struct IndicesComprimidos ) );
+    comprimidos->codificacion = codificacion;
+    comprimidos->primero = e[ 0 ];
+    comprimidos->memoria = memoria;
+
+    // Se reserva el caso peor de cada codificación (una racha por índice)
+    comprimidos->reservados = codificacion == CODIFICACION_PLANA ?
+        R * sizeof( int ) : codificacion == CODIFICACION_DELTA16 ?
+        R * sizeof( short ) : codificacion == CODIFICACION_DELTA8 ? R :
+        R * sizeof( struct Racha );
+    comprimidos->bytes = comprimidos->reservados;
+
+    // Las diferencias de 16 bits deben caber todas
+    for( j = 1; codificacion == CODIFICACION_DELTA16 && j < R; j++ )
+    {
+        delta = ( long )e[ j ] - e[ j - 1 ];
+
+        if( delta < -32768 || delta > 32767 )
+        {
+            return( 0 );
+        }
+    }
+
+    if( ( comprimidos->datos = reservarBloque( memoria,
+        comprimidos->reservados, alineamiento ) ) == NULL )
+    {
+        perror( "Reserva de memoria fallida" );
+        exit( EXIT_FAILURE );
+    }
+
+    switch( codificacion )
+    {
+        case CODIFICACION_PLANA:
+            memcpy( comprimidos->datos, e, R * sizeof( int ) );
+            break;
+
+        case CODIFICACION_DELTA16:
+            deltas16 = comprimidos->datos;
+            deltas16[ 0 ] = 0;
+
+            for( j = 1; j < R; j++ )
+            {
+                deltas16[ j ] = ( short )( e[ j ] - e[ j - 1 ] );
+            }
+            break;
+
+        case CODIFICACION_DELTA8:
+            deltas8 = comprimidos->datos;
+            deltas8[ 0 ] = 0;
+
+            if( ( comprimidos->escapes = malloc( R * sizeof( int ) ) ) ==
+                NULL )
+            {
+                perror( "Reserva de memoria fallida" );
+                exit( EXIT_FAILURE );
+            }
+
+            for( j = 1; j < R; j++ )
+            {
+                delta = ( long )e[ j ] - e[ j - 1 ];
+
+                if( delta > ESCAPE_DELTA8 && delta <= 127 )
+                {
+                    deltas8[ j ] = ( signed char )delta;
+                }
+                else
+                {
+                    deltas8[ j ] = ESCAPE_DELTA8;
+                    comprimidos->escapes[ comprimidos->numEscapes++ ] =
+                        ( int )delta;
+                }
+            }
+            break;
+
+        case CODIFICACION_RLE:
+            rachas = comprimidos->datos;
+
+            for( j = 1; j < R; j++ )
+            {
+                delta = ( long )e[ j ] - e[ j - 1 ];
+
+                if( comprimidos->numRachas > 0 &&
+                    rachas[ comprimidos->numRachas - 1 ].delta == delta )
+                {
+                    rachas[ comprimidos->numRachas - 1 ].longitud++;
+                }
+                else
+                {
+                    rachas[ comprimidos->numRachas ].delta = ( int )delta;
+                    rachas[ comprimidos->numRachas++ ].longitud = 1;
+                }
+            }
+            break;
+    }
+
+    // Se cuentan los bytes que realmente se recorren: las rachas usadas y
+    // los escapes, junto con el primer índice
+    if( codificacion == CODIFICACION_RLE )
+    {
+        comprimidos->bytes = comprimidos->numRachas * sizeof( struct Racha );
+    }
+
+    if( codificacion != CODIFICACION_PLANA )
+    {
+        comprimidos->bytes += sizeof( int ) + comprimidos->numEscapes *
+            sizeof( int );
+    }
+
+    return( 1 );
+}
+
+
+void liberarIndicesComprimidos( struct IndicesComprimidos *comprimidos )
+{
+    liberarBloque( comprimidos->memoria, comprimidos->datos,
+        comprimidos->reservados );
+    free( comprimidos->escapes );
+
+    comprimidos->datos = NULL;
+    comprimidos->escapes = NULL;
+}
+
+
+/* Suma prefija de los 8 enteros del vector, partiendo de base: el elemento
+   k pasa a ser base + v[ 0 ] + ... + v[ k ] */
+__attribute__(( target( "avx2" ) ))
+static inline __m256i sumaPrefija( __m256i v, int base )
+{
+    __m256i ultimo;
+
+
+    // Dentro de cada mitad de 128 bits, desplazando 1 y 2 elementos
+    v = _mm256_add_epi32( v, _mm256_slli_si256( v, 4 ) );
+    v = _mm256_add_epi32( v, _mm256_slli_si256( v, 8 ) );
+
+    // Y se añade el último de la mitad baja a toda la mitad alta
+    ultimo = _mm256_shuffle_epi32( v, 0xFF );
+    v = _mm256_add_epi32( v, _mm256_permute2x128_si256( ultimo, ultimo,
+        0x08 ) );
+
+    return( _mm256_add_epi32( v, _mm256_set1_epi32( base ) ) );
+}
+
+
+/* Suma los 8 elementos de A indicados por el vector de índices, y deja en
+   indice el último */
+#define SUMAR_OCHO( VECTOR ) \
+    _mm256_store_si256( ( __m256i * )indices, VECTOR ); \
+    \
+    _Pragma( "GCC unroll 8" ) \
+    for( k = 0; k < 8; k++ ) \
+    { \
+        suma += valoresA[ indices[ k ] ]; \
+    } \
+    \
+    indice = indices[ 7 ];
+
+
+static void nucleoPlano( const struct Medida *medida, double *valoresS )
+{
+    const double *valoresA = medida->valoresA;
+    const int *e = ( ( const struct IndicesComprimidos * )
+        medida->comprimidos )->datos;
+    long R = medida->R;
+
+    double suma;
+    long j;
+    int i;
+
+
+    for( i = 0; i < NUM_S; i++ )
+    {
+        for( j = 0, suma = 0; j < R; j++ )
+        {
+            suma += valoresA[ e[ j ] ];
+        }
+
+        valoresS[ i ] = suma;
+    }
+}
+
+
+__attribute__(( target( "avx2" ) ))
+static void nucleoDelta16( const struct Medida *medida, double *valoresS )
+{
+    const struct IndicesComprimidos *comprimidos = medida->comprimidos;
+    const double *valoresA = medida->valoresA;
+    const short *deltas = comprimidos->datos;
+    long R = medida->R;
+
+    int indices[ 8 ] __attribute__(( aligned( 32 ) ));
+    int indice;
+
+    double suma;
+    long j;
+    int i;
+    int k;
+
+
+    for( i = 0; i < NUM_S; i++ )
+    {
+        indice = comprimidos->primero;
+        suma = valoresA[ indice ];
+
+        // Se extienden 8 diferencias a 32 bits y se acumulan
+        for( j = 1; j + 8 <= R; j += 8 )
+        {
+            SUMAR_OCHO( sumaPrefija( _mm256_cvtepi16_epi32( _mm_loadu_si128(
+                ( const __m128i * )( deltas + j ) ) ), indice ) );
+        }
+
+        for( ; j < R; j++ )
+        {
+            indice += deltas[ j ];
+            suma += valoresA[ indice ];
+        }
+
+        valoresS[ i ] = suma;
+    }
+}
+
+
+__attribute__(( target( "avx2" ) ))
+static void nucleoDelta8( const struct Medida *medida, double *valoresS )
+{
+    const struct IndicesComprimidos *comprimidos = medida->comprimidos;
+    const double *valoresA = medida->valoresA;
+    const signed char *deltas = comprimidos->datos;
+    const int *escapes = comprimidos->escapes;
+    long R = medida->R;
+
+    int indices[ 8 ] __attribute__(( aligned( 32 ) ));
+    int indice;
+
+    // Diferencias del grupo y siguiente escape a leer
+    __m128i grupo;
+    long escape;
+
+    double suma;
+    long j;
+    int i;
+    int k;
+
+
+    for( i = 0; i < NUM_S; i++ )
+    {
+        indice = comprimidos->primero;
+        suma = valoresA[ indice ];
+
+        for( j = 1, escape = 0; j + 8 <= R; j += 8 )
+        {
+            grupo = _mm_loadl_epi64( ( const __m128i * )( deltas + j ) );
+
+            // Los grupos con algún escape se decodifican de uno en uno
+            if( _mm_movemask_epi8( _mm_cmpeq_epi8( grupo,
+                _mm_set1_epi8( ESCAPE_DELTA8 ) ) ) != 0 )
+            {
+                for( k = 0; k < 8; k++ )
+                {
+                    indice += deltas[ j + k ] == ESCAPE_DELTA8 ?
+                        escapes[ escape++ ] : deltas[ j + k ];
+                    suma += valoresA[ indice ];
+                }
+                continue;
+            }
+
+            SUMAR_OCHO( sumaPrefija( _mm256_cvtepi8_epi32( grupo ),
+                indice ) );
+        }
+
+        for( ; j < R; j++ )
+        {
+            indice += deltas[ j ] == ESCAPE_DELTA8 ? escapes[ escape++ ] :
+                deltas[ j ];
+            suma += valoresA[ indice ];
+        }
+
+        valoresS[ i ] = suma;
+    }
+}
+
+
+__attribute__(( target( "avx2" ) ))
+static void nucleoRle( const struct Medida *medida, double *valoresS )
+{
+    const struct IndicesComprimidos *comprimidos = medida->comprimidos;
+    const double *valoresA = medida->valoresA;
+    const struct Racha *rachas = comprimidos->datos;
+    long numRachas = comprimidos->numRachas;
+
+    int indices[ 8 ] __attribute__(( aligned( 32 ) ));
+    int indice;
+
+    // Índices de los 8 accesos siguientes de la racha, y su incremento
+    __m256i siguientes;
+    __m256i paso;
+    int delta;
+    int n;
+
+    double suma;
+    long r;
+    int i;
+    int k;
+
+
+    for( i = 0; i < NUM_S; i++ )
+    {
+        indice = comprimidos->primero;
+        suma = valoresA[ indice ];
+
+        for( r = 0; r < numRachas; r++ )
+        {
+            delta = rachas[ r ].delta;
+            siguientes = _mm256_add_epi32( _mm256_set1_epi32( indice ),
+                _mm256_mullo_epi32( _mm256_set1_epi32( delta ),
+                _mm256_setr_epi32( 1, 2, 3, 4, 5, 6, 7, 8 ) ) );
+            paso = _mm256_set1_epi32( 8 * delta );
+
+            for( n = rachas[ r ].longitud; n >= 8; n -= 8 )
+            {
+                SUMAR_OCHO( siguientes );
+                siguientes = _mm256_add_epi32( siguientes, paso );
+            }
+
+            for( ; n > 0; n-- )
+            {
+                indice += delta;
+                suma += valoresA[ indice ];
+            }
+        }
+
+        valoresS[ i ] = suma;
+    }
+}
+
+
+// Núcleo de cada codificación
+static void ( * const nucleos[ NUM_CODIFICACIONES ] )(
+    const struct Medida *, double * ) =
+{
+    [ CODIFICACION_PLANA ] = nucleoPlano,
+    [ CODIFICACION_DELTA16 ] = nucleoDelta16,
+    [ CODIFICACION_DELTA8 ] = nucleoDelta8,
+    [ CODIFICACION_RLE ] = nucleoRle
+};
+
+
+void nucleoComprimido( const struct Medida *medida, double *valoresS )
+{
+    nucleos[ ( ( const struct IndicesComprimidos * )
+        medida->comprimidos )->codificacion ]( medida, valoresS );
+}
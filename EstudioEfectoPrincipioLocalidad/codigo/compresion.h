@@ -0,0 +1,84 @@
+#ifndef COMPRESION_H
+#define COMPRESION_H
+
+#include <stddef.h>
+
+#include "modos.h"
+
+
+/* Macros varias */
+
+// Delta de 8 bits que indica que el verdadero está en el vector de escapes
+#define ESCAPE_DELTA8 -128
+
+
+/* Codificaciones del flujo de índices de e[] */
+enum Codificacion
+{
+    CODIFICACION_PLANA,     // Índices de 32 bits sin comprimir (referencia)
+    CODIFICACION_DELTA16,   // Diferencias de 16 bits con el anterior
+    CODIFICACION_DELTA8,    // Diferencias de 8 bits, con escapes de 32
+    CODIFICACION_RLE,       // Rachas de diferencias iguales (delta, número)
+    NUM_CODIFICACIONES
+};
+
+
+/* Listas de índices que se comprimen: la de junto, con diferencias
+   constantes, y otras más irregulares que ejercitan los escapes y las
+   rachas cortas */
+enum FuenteIndices
+{
+    FUENTE_JUNTO,       // Múltiplos de D, sin desplazamientos
+    FUENTE_ENTORNO,     // Desplazados dentro de ENTORNO, como en precarga
+    FUENTE_PAGINA,      // Patrón pagina: aleatorio dentro de cada página
+                        // (diferencias dentro y fuera de 8 bits mezcladas)
+    NUM_FUENTES
+};
+
+
+/* Racha de la codificación RLE: longitud índices seguidos, cada uno delta
+   posiciones más allá del anterior */
+struct Racha
+{
+    int delta;
+    int longitud;
+};
+
+
+/* Flujo de índices codificado; el primer índice se guarda aparte y el
+   resto se reconstruye a partir de él */
+struct IndicesComprimidos
+{
+    int codificacion;
+    int primero;
+
+    // Índices, diferencias o rachas según la codificación, y bytes que
+    // ocupan; en las diferencias, la posición j guarda e[ j ] - e[ j - 1 ]
+    void *datos;
+    size_t bytes;
+    long numRachas;
+
+    // Diferencias que no caben en 8 bits, en orden de aparición
+    int *escapes;
+    long numEscapes;
+
+    // Forma en la que se ha reservado datos (enum TipoMemoria) y bytes
+    // reservados
+    int memoria;
+    size_t reservados;
+};
+
+
+extern const char *nombresCodificaciones[ NUM_CODIFICACIONES ];
+extern const char *nombresFuentes[ NUM_FUENTES ];
+
+
+/* Prototipos de las funciones a emplear */
+int buscarCodificacion( const char *nombre );
+int comprimirIndices( const int *e, long R, int codificacion, int memoria,
+    size_t alineamiento, struct IndicesComprimidos *comprimidos );
+void liberarIndicesComprimidos( struct IndicesComprimidos *comprimidos );
+void nucleoComprimido( const struct Medida *medida, double *valoresS );
+
+
+#endif
@@ -0,0 +1,256 @@
+#include <stdio.h>
+#include <time.h>
+#include <cpuid.h>
+#include <x86intrin.h>
+
+#include "contador.h"
+
+
+/*
+Contador de ciclos basado en el TSC. La lectura inicial se aísla con lfence
+antes y después de rdtsc, de modo que no empiece antes de que terminen las
+instrucciones previas ni deje que las siguientes se adelanten; la final usa
+rdtscp, que espera a que terminen las instrucciones medidas, seguida de otro
+lfence. La sobrecarga de una pareja de lecturas se mide al calibrar y se
+descuenta de cada intervalo.
+
+La frecuencia del TSC se obtiene de la hoja 0x15 de CPUID (cristal por
+cociente TSC/cristal) cuando la CPU la rellena, y si no, comparándolo durante
+unos milisegundos con CLOCK_MONOTONIC_RAW. Sin TSC invariante o sin rdtscp se
+recurre a clock_gettime( CLOCK_MONOTONIC_RAW ), convirtiendo los nanosegundos
+en ciclos con la frecuencia base de la hoja 0x16 (o 1 GHz si no la indica).
+*/
+
+
+/* Macros varias */
+
+// Parejas de lecturas con las que se mide la sobrecarga del contador
+#define LECTURAS_SOBRECARGA 1000
+
+// Duración de la comparación con CLOCK_MONOTONIC_RAW, en nanosegundos
+#define DURACION_CALIBRADO 20000000LL
+
+// Frecuencia supuesta si no se puede obtener de la CPU, en MHz
+#define FRECUENCIA_DEFECTO 1000.0
+
+
+// Si se emplea el TSC o clock_gettime, frecuencia en MHz y sobrecarga en
+// ciclos de cada intervalo, y lectura de start_counter
+static int usarTsc = 1;
+static double frecuencia = FRECUENCIA_DEFECTO;
+static double sobrecarga = 0;
+static unsigned long long inicio = 0;
+
+
+/* Nanosegundos de CLOCK_MONOTONIC_RAW */
+static long long leerReloj( void )
+{
+    struct timespec t;
+
+
+    clock_gettime( CLOCK_MONOTONIC_RAW, &t );
+
+    return( t.tv_sec * 1000000000LL + t.tv_nsec );
+}
+
+
+/* Lectura al comienzo de un intervalo */
+static inline unsigned long long leerInicio( void )
+{
+    unsigned long long t;
+
+
+    if( !usarTsc )
+    {
+        return( ( unsigned long long )( leerReloj() * frecuencia / 1e3 ) );
+    }
+
+    _mm_lfence();
+    t = __rdtsc();
+    _mm_lfence();
+
+    return( t );
+}
+
+
+/* Lectura al final de un intervalo */
+static inline unsigned long long leerFin( void )
+{
+    unsigned long long t;
+    unsigned procesador;
+
+
+    if( !usarTsc )
+    {
+        return( ( unsigned long long )( leerReloj() * frecuencia / 1e3 ) );
+    }
+
+    t = __rdtscp( &procesador );
+    _mm_lfence();
+
+    return( t );
+}
+
+
+void start_counter( void )
+{
+    inicio = leerInicio();
+}
+
+
+double get_counter( void )
+{
+    double ciclos;
+
+
+    ciclos = ( double )( leerFin() - inicio ) - sobrecarga;
+
+    return( ciclos > 0 ? ciclos : 0 );
+}
+
+
+unsigned long long leerCiclos( void )
+{
+    return( leerInicio() );
+}
+
+
+/* Comprueba si el TSC es invariante y existe rdtscp */
+static int tscUtilizable( void )
+{
+    unsigned eax, ebx, ecx, edx;
+
+
+    if( __get_cpuid_max( 0x80000000, NULL ) < 0x80000007 )
+    {
+        return( 0 );
+    }
+
+    // rdtscp en el bit 27 de edx de 0x80000001, e invariante en el 8 de
+    // 0x80000007
+    __cpuid( 0x80000001, eax, ebx, ecx, edx );
+
+    if( !( edx & ( 1 << 27 ) ) )
+    {
+        return( 0 );
+    }
+
+    __cpuid( 0x80000007, eax, ebx, ecx, edx );
+
+    return( ( edx >> 8 ) & 1 );
+}
+
+
+/* Frecuencia del TSC según la hoja 0x15 de CPUID, en MHz (0 si no la da) */
+static double frecuenciaCpuid( void )
+{
+    unsigned eax, ebx, ecx, edx;
+
+
+    if( __get_cpuid_max( 0, NULL ) < 0x15 )
+    {
+        return( 0 );
+    }
+
+    // Cociente TSC/cristal en ebx/eax y frecuencia del cristal en ecx
+    __cpuid_count( 0x15, 0, eax, ebx, ecx, edx );
+
+    if( eax == 0 || ebx == 0 || ecx == 0 )
+    {
+        return( 0 );
+    }
+
+    return( ( double )ecx * ebx / eax / 1e6 );
+}
+
+
+/* Frecuencia base de la CPU según la hoja 0x16 de CPUID, en MHz (0 si no la
+   da) */
+static double frecuenciaBase( void )
+{
+    unsigned eax, ebx, ecx, edx;
+
+
+    if( __get_cpuid_max( 0, NULL ) < 0x16 )
+    {
+        return( 0 );
+    }
+
+    __cpuid_count( 0x16, 0, eax, ebx, ecx, edx );
+
+    return( eax & 0xFFFF );
+}
+
+
+/* Frecuencia del TSC comparándolo con CLOCK_MONOTONIC_RAW, en MHz */
+static double frecuenciaReloj( void )
+{
+    unsigned long long tscInicio;
+    unsigned long long tscFin;
+    long long relojInicio;
+    long long relojFin;
+
+
+    relojInicio = leerReloj();
+    tscInicio = leerInicio();
+
+    do
+    {
+        relojFin = leerReloj();
+    }
+    while( relojFin - relojInicio < DURACION_CALIBRADO );
+
+    tscFin = leerFin();
+
+    return( 1e3 * ( tscFin - tscInicio ) / ( relojFin - relojInicio ) );
+}
+
+
+double calibrarContador( struct Calibracion *calibracion, FILE *salida )
+{
+    // Menor duración de una pareja de lecturas seguidas
+    unsigned long long t;
+    unsigned long long minimo;
+
+    // Contador
+    int i;
+
+
+    usarTsc = tscUtilizable();
+
+    if( usarTsc && ( frecuencia = frecuenciaCpuid() ) > 0 )
+    {
+        calibracion->origen = "cpuid 0x15";
+    }
+    else if( usarTsc )
+    {
+        frecuencia = frecuenciaReloj();
+        calibracion->origen = "CLOCK_MONOTONIC_RAW";
+    }
+    else
+    {
+        frecuencia = frecuenciaBase() > 0 ? frecuenciaBase() :
+            FRECUENCIA_DEFECTO;
+        calibracion->origen = "clock_gettime, sin TSC invariante";
+    }
+
+    // Se toma el mínimo, que corresponde a las parejas no interrumpidas
+    for( i = 0, minimo = ~0ULL; i < LECTURAS_SOBRECARGA; i++ )
+    {
+        t = leerInicio();
+        t = leerFin() - t;
+        minimo = t < minimo ? t : minimo;
+    }
+
+    sobrecarga = minimo;
+
+    calibracion->frecuencia = frecuencia;
+    calibracion->sobrecarga = sobrecarga;
+    calibracion->contador = usarTsc ? "rdtscp" : "CLOCK_MONOTONIC_RAW";
+
+    fprintf( salida, "Contador %s a %1.1lf MHz (%s), sobrecarga %1.0lf "
+        "ciclos\n", calibracion->contador, frecuencia, calibracion->origen,
+        sobrecarga );
+
+    return( frecuencia );
+}
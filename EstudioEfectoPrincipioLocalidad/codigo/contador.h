@@ -0,0 +1,33 @@
+#ifndef CONTADOR_H
+#define CONTADOR_H
+
+#include <stdio.h>
+
+
+/* Resultado de calibrar el contador */
+struct Calibracion
+{
+    // Frecuencia en MHz y sobrecarga descontada de cada intervalo, en ciclos
+    double frecuencia;
+    double sobrecarga;
+
+    // Contador empleado ("rdtscp" o "CLOCK_MONOTONIC_RAW") y origen de la
+    // frecuencia
+    const char *contador;
+    const char *origen;
+};
+
+
+/* Contador de ciclos serializado con lfence y rdtscp; la diferencia entre
+   start_counter y get_counter descuenta la sobrecarga del propio contador */
+void start_counter( void );
+double get_counter( void );
+
+/* Calibra el contador y devuelve su frecuencia, en MHz */
+double calibrarContador( struct Calibracion *calibracion, FILE *salida );
+
+/* Lectura directa del contador, válida desde varios hilos a la vez */
+unsigned long long leerCiclos( void );
+
+
+#endif
@@ -0,0 +1,161 @@
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "datos.h"
+#include "memoria.h"
+
+
+/*
+Caché en disco del vector A. Generar los valores con rand() lleva más tiempo
+que las propias medidas en los puntos mayores, así que cada conjunto de datos
+se genera una vez y se guarda en un fichero identificado por la semilla y el
+número de valores. En ejecuciones posteriores el fichero se proyecta con
+MAP_POPULATE, que lo lee de una vez, y se copia a la memoria de la arena, de
+modo que se conservan la forma de reserva y la colocación NUMA pedidas.
+*/
+
+
+/* Prototipos de las funciones a emplear */
+static void nombrarDatos( char *ruta, size_t tam, const char *directorio,
+    unsigned semilla, size_t numValores );
+static int leerDatos( const char *ruta, unsigned semilla, double *valoresA,
+    size_t numValores );
+static void guardarDatos( const char *ruta, unsigned semilla,
+    const double *valoresA, size_t numValores );
+
+
+static void nombrarDatos( char *ruta, size_t tam, const char *directorio,
+    unsigned semilla, size_t numValores )
+{
+    snprintf( ruta, tam, "%s/valoresA-v%d-%u-%zu.bin", directorio,
+        VERSION_DATOS, semilla, numValores );
+}
+
+
+static int leerDatos( const char *ruta, unsigned semilla, double *valoresA,
+    size_t numValores )
+{
+    const struct CabeceraDatos *cabecera;
+    struct stat info;
+
+    // Fichero proyectado en memoria y su tamaño esperado
+    char *proyeccion;
+    size_t tam;
+
+    int fichero;
+    int valido;
+
+
+    if( ( fichero = open( ruta, O_RDONLY ) ) == -1 )
+    {
+        return( 0 );
+    }
+
+    tam = sizeof( struct CabeceraDatos ) + numValores * sizeof( double );
+
+    if( fstat( fichero, &info ) != 0 || ( size_t )info.st_size != tam )
+    {
+        close( fichero );
+        return( 0 );
+    }
+
+    // Se leen todas las páginas al proyectar, en lugar de provocar un fallo
+    // de página por cada una al copiarlas
+    proyeccion = mmap( NULL, tam, PROT_READ, MAP_PRIVATE | MAP_POPULATE,
+        fichero, 0 );
+    close( fichero );
+
+    if( proyeccion == MAP_FAILED )
+    {
+        perror( "mmap del fichero de datos" );
+        return( 0 );
+    }
+
+    // Se comprueba que el fichero corresponde a la versión, semilla y
+    // tamaño pedidos antes de usarlo
+    cabecera = ( const struct CabeceraDatos * )proyeccion;
+    valido = memcmp( cabecera->magica, MAGICA_DATOS, sizeof(
+        cabecera->magica ) ) == 0 && cabecera->version == VERSION_DATOS &&
+        cabecera->semilla == semilla && cabecera->numValores == numValores &&
+        cabecera->tamValor == sizeof( double );
+
+    if( valido )
+    {
+        memcpy( valoresA, proyeccion + sizeof( struct CabeceraDatos ),
+            numValores * sizeof( double ) );
+    }
+
+    munmap( proyeccion, tam );
+
+    return( valido );
+}
+
+
+static void guardarDatos( const char *ruta, unsigned semilla,
+    const double *valoresA, size_t numValores )
+{
+    struct CabeceraDatos cabecera;
+
+    // Se escribe en un fichero temporal que se renombra al terminar, para
+    // que ninguna otra ejecución lea un fichero a medias
+    char temporal[ TAM_RUTA + 16 ];
+    FILE *fichero;
+
+
+    snprintf( temporal, sizeof( temporal ), "%s.%d", ruta, ( int )getpid() );
+
+    if( ( fichero = fopen( temporal, "wb" ) ) == NULL )
+    {
+        perror( "No se ha podido crear el fichero de datos" );
+        return;
+    }
+
+    memset( &cabecera, 0, sizeof( cabecera ) );
+    memcpy( cabecera.magica, MAGICA_DATOS, sizeof( cabecera.magica ) );
+    cabecera.version = VERSION_DATOS;
+    cabecera.semilla = semilla;
+    cabecera.numValores = numValores;
+    cabecera.tamValor = sizeof( double );
+
+    if( fwrite( &cabecera, sizeof( cabecera ), 1, fichero ) != 1 ||
+        fwrite( valoresA, sizeof( double ), numValores, fichero ) !=
+        numValores )
+    {
+        perror( "No se ha podido escribir el fichero de datos" );
+        fclose( fichero );
+        unlink( temporal );
+        return;
+    }
+
+    if( fclose( fichero ) != 0 || rename( temporal, ruta ) != 0 )
+    {
+        perror( "No se ha podido guardar el fichero de datos" );
+        unlink( temporal );
+    }
+}
+
+
+void obtenerDatos( const char *directorio, unsigned semilla,
+    double *valoresA, size_t numValores )
+{
+    char ruta[ TAM_RUTA ];
+
+
+    nombrarDatos( ruta, sizeof( ruta ), directorio, semilla, numValores );
+
+    if( leerDatos( ruta, semilla, valoresA, numValores ) )
+    {
+        return;
+    }
+
+    // Si no existe (o no es válido) se generan los valores igual que sin
+    // fichero de datos y se guardan para las siguientes ejecuciones
+    srand( semilla );
+    generarValores( valoresA, 0, numValores );
+    guardarDatos( ruta, semilla, valoresA, numValores );
+}
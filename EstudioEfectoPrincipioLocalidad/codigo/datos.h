@@ -0,0 +1,34 @@
+#ifndef DATOS_H
+#define DATOS_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+
+/* Macros varias */
+#define MAGICA_DATOS "LOCALIDA"
+#define VERSION_DATOS 1
+#define TAM_RUTA 4096
+
+
+/* Cabecera de los ficheros de datos; los valores del vector A la siguen
+   directamente */
+struct CabeceraDatos
+{
+    char magica[ 8 ];
+    uint32_t version;
+    uint32_t semilla;
+    uint64_t numValores;
+
+    // Tamaño de un double, para rechazar ficheros de otra arquitectura
+    uint32_t tamValor;
+    uint32_t reservado;
+};
+
+
+/* Prototipos de las funciones a emplear */
+void obtenerDatos( const char *directorio, unsigned semilla,
+    double *valoresA, size_t numValores );
+
+
+#endif
@@ -0,0 +1,95 @@
+#include <emmintrin.h>
+
+#include "escritura.h"
+
+
+/*
+Variantes de directo.c que escriben en el vector A en lugar de leerlo. En la
+escritura simple cada línea tocada se trae antes a caché (write-allocate) y,
+al quedar modificada, su expulsión supone además una escritura en el
+siguiente nivel; la actualización (lectura-modificación-escritura) paga lo
+mismo más la dependencia con la lectura. Con los almacenamientos no
+temporales de _mm_stream_pd los datos van directamente a memoria sin reservar
+la línea, lo que sólo compensa cuando el conjunto de trabajo no cabe en
+caché. Los tres escriben sobre una copia del vector A (ver
+reservarEscritura), de modo que el resto de modos no ve sus escrituras.
+*/
+
+
+void nucleoEscritura( const struct Medida *medida, double *valoresS )
+{
+    double *valoresA = medida->valoresA;
+    long R = medida->R;
+    long D = medida->D;
+
+    long j;
+    int i;
+
+
+    for( i = 0; i < NUM_S; i++ )
+    {
+        // Sólo se escribe; el valor depende de la pasada para que el
+        // compilador no pueda fusionar las pasadas
+        for( j = 0; j < R; j++ )
+        {
+            valoresA[ j * D ] = i;
+        }
+
+        // Se guarda como reducción uno de los valores escritos
+        valoresS[ i ] = valoresA[ ( R - 1 ) * D ];
+    }
+}
+
+
+void nucleoActualizacion( const struct Medida *medida, double *valoresS )
+{
+    double *valoresA = medida->valoresA;
+    long R = medida->R;
+    long D = medida->D;
+
+    long j;
+    int i;
+
+
+    for( i = 0; i < NUM_S; i++ )
+    {
+        // Cada acceso lee el elemento y escribe el resultado en su lugar
+        for( j = 0; j < R; j++ )
+        {
+            valoresA[ j * D ] += i;
+        }
+
+        valoresS[ i ] = valoresA[ ( R - 1 ) * D ];
+    }
+}
+
+
+void nucleoFlujo( const struct Medida *medida, double *valoresS )
+{
+    double *valoresA = medida->valoresA;
+    long R = medida->R;
+    long D = medida->D;
+
+    __m128d valor;
+    long j;
+    int i;
+
+
+    for( i = 0; i < NUM_S; i++ )
+    {
+        valor = _mm_set1_pd( i );
+
+        // _mm_stream_pd requiere una dirección alineada a 16 bytes, por lo
+        // que se escribe la pareja de doubles que contiene el elemento
+        for( j = 0; j < R; j++ )
+        {
+            _mm_stream_pd( &valoresA[ ( j * D ) & ~1L ], valor );
+        }
+
+        // Los almacenamientos no temporales no están ordenados con el resto;
+        // se espera a que se completen para que cuenten en la medida
+        _mm_sfence();
+
+        valoresS[ i ] = valoresA[ ( R - 1 ) * D ];
+    }
+}
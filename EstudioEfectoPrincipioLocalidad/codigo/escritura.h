@@ -0,0 +1,13 @@
+#ifndef ESCRITURA_H
+#define ESCRITURA_H
+
+#include "modos.h"
+
+
+/* Prototipos de las funciones a emplear */
+void nucleoEscritura( const struct Medida *medida, double *valoresS );
+void nucleoActualizacion( const struct Medida *medida, double *valoresS );
+void nucleoFlujo( const struct Medida *medida, double *valoresS );
+
+
+#endif
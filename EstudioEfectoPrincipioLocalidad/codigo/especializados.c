@@ -0,0 +1,165 @@
+#include <stdio.h>
+
+#include "especializados.h"
+
+
+/*
+Recorrido de directo (valoresA[ j * D ]) con D y el desenrollado U fijados
+al compilar. En directo D es una variable, de modo que cada acceso calcula
+j * D y el bucle avanza de uno en uno; con D constante las U lecturas de
+cada iteración usan desplazamientos inmediatos sobre un único puntero, y
+sólo queda un incremento y un salto cada U accesos.
+
+Se instancia una función por cada paso de 1 a PASO_MAXIMO (potencias de 2)
+y cada desenrollado de 1 a MAX_DESENROLLADO; el resto de pasos usa un bucle
+genérico con el mismo desenrollado y D variable. Las sumas se realizan en el
+mismo orden y con un único acumulador que en directo, de modo que la
+reducción es idéntica y la diferencia de tiempo con directo es la sobrecarga
+del propio bucle.
+*/
+
+
+/* Núcleo con paso D y desenrollado U; se avanza un puntero U * D elementos
+   en cada iteración */
+#define NUCLEO_ESPECIALIZADO( nombre, D, U ) \
+static void nombre( const struct Medida *medida, double *valoresS ) \
+{ \
+    const double *elemento; \
+    long R = medida->R; \
+    \
+    double suma; \
+    long j; \
+    int i; \
+    int k; \
+    \
+    \
+    for( i = 0; i < NUM_S; i++ ) \
+    { \
+        elemento = medida->valoresA; \
+        \
+        for( j = 0, suma = 0; j + U <= R; j += U, elemento += U * D ) \
+        { \
+            _Pragma( "GCC unroll 8" ) \
+            for( k = 0; k < U; k++ ) \
+            { \
+                suma += elemento[ k * D ]; \
+            } \
+        } \
+        \
+        for( ; j < R; j++, elemento += D ) \
+        { \
+            suma += elemento[ 0 ]; \
+        } \
+        \
+        valoresS[ i ] = suma; \
+    } \
+}
+
+
+/* Núcleo genérico con desenrollado U y el paso de la medida */
+#define NUCLEO_GENERICO( nombre, U ) \
+    NUCLEO_ESPECIALIZADO( nombre, medida->D, U )
+
+
+/* Núcleos de un paso con cada desenrollado, y fila de la tabla con ellos */
+#define NUCLEOS_PASO( D ) \
+    NUCLEO_ESPECIALIZADO( nucleoD##D##U1, D, 1 ) \
+    NUCLEO_ESPECIALIZADO( nucleoD##D##U2, D, 2 ) \
+    NUCLEO_ESPECIALIZADO( nucleoD##D##U3, D, 3 ) \
+    NUCLEO_ESPECIALIZADO( nucleoD##D##U4, D, 4 ) \
+    NUCLEO_ESPECIALIZADO( nucleoD##D##U5, D, 5 ) \
+    NUCLEO_ESPECIALIZADO( nucleoD##D##U6, D, 6 ) \
+    NUCLEO_ESPECIALIZADO( nucleoD##D##U7, D, 7 ) \
+    NUCLEO_ESPECIALIZADO( nucleoD##D##U8, D, 8 )
+
+#define FILA_PASO( D ) \
+    { nucleoD##D##U1, nucleoD##D##U2, nucleoD##D##U3, nucleoD##D##U4, \
+      nucleoD##D##U5, nucleoD##D##U6, nucleoD##D##U7, nucleoD##D##U8 }
+
+
+NUCLEOS_PASO( 1 )
+NUCLEOS_PASO( 2 )
+NUCLEOS_PASO( 4 )
+NUCLEOS_PASO( 8 )
+NUCLEOS_PASO( 16 )
+NUCLEOS_PASO( 32 )
+NUCLEOS_PASO( 64 )
+
+NUCLEO_GENERICO( nucleoGenerico1, 1 )
+NUCLEO_GENERICO( nucleoGenerico2, 2 )
+NUCLEO_GENERICO( nucleoGenerico3, 3 )
+NUCLEO_GENERICO( nucleoGenerico4, 4 )
+NUCLEO_GENERICO( nucleoGenerico5, 5 )
+NUCLEO_GENERICO( nucleoGenerico6, 6 )
+NUCLEO_GENERICO( nucleoGenerico7, 7 )
+NUCLEO_GENERICO( nucleoGenerico8, 8 )
+
+
+// Núcleo de cada paso (por su logaritmo en base 2) y desenrollado (menos 1)
+static void ( * const nucleos[ NUM_PASOS ][ MAX_DESENROLLADO ] )(
+    const struct Medida *, double * ) =
+{
+    FILA_PASO( 1 ), FILA_PASO( 2 ), FILA_PASO( 4 ), FILA_PASO( 8 ),
+    FILA_PASO( 16 ), FILA_PASO( 32 ), FILA_PASO( 64 )
+};
+
+// Núcleo genérico de cada desenrollado (menos 1)
+static void ( * const genericos[ MAX_DESENROLLADO ] )(
+    const struct Medida *, double * ) =
+{
+    nucleoGenerico1, nucleoGenerico2, nucleoGenerico3, nucleoGenerico4,
+    nucleoGenerico5, nucleoGenerico6, nucleoGenerico7, nucleoGenerico8
+};
+
+
+/* Devuelve la fila de la tabla del paso D, o -1 si no tiene núcleo propio */
+static int filaPaso( long D )
+{
+    // Fila y paso que le corresponde
+    int fila;
+    long paso;
+
+
+    for( fila = 0, paso = 1; fila < NUM_PASOS; fila++, paso *= 2 )
+    {
+        if( paso == D )
+        {
+            return( fila );
+        }
+    }
+
+    return( -1 );
+}
+
+
+int pasoEspecializado( long D )
+{
+    return( filaPaso( D ) >= 0 );
+}
+
+
+void describirEspecializado( int desenrollado, int generico, char *texto,
+    int tam )
+{
+    snprintf( texto, tam, "%s u%d", generico ? "variable" : "fijo",
+        desenrollado );
+}
+
+
+void nucleoEspecializado( const struct Medida *medida, double *valoresS )
+{
+    // Fila del paso de la medida
+    int fila;
+
+
+    fila = filaPaso( medida->D );
+
+    if( medida->generico || fila < 0 )
+    {
+        genericos[ medida->desenrollado - 1 ]( medida, valoresS );
+    }
+    else
+    {
+        nucleos[ fila ][ medida->desenrollado - 1 ]( medida, valoresS );
+    }
+}
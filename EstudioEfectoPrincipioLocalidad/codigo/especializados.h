@@ -0,0 +1,21 @@
+#ifndef ESPECIALIZADOS_H
+#define ESPECIALIZADOS_H
+
+#include "modos.h"
+
+
+/* Macros varias */
+
+// Pasos D con núcleo propio: 1, 2, 4, ..., PASO_MAXIMO
+#define NUM_PASOS 7
+#define PASO_MAXIMO 64
+
+
+/* Prototipos de las funciones a emplear */
+int pasoEspecializado( long D );
+void describirEspecializado( int desenrollado, int generico, char *texto,
+    int tam );
+void nucleoEspecializado( const struct Medida *medida, double *valoresS );
+
+
+#endif
@@ -0,0 +1,40 @@
+#ifndef ESTADISTICA_H
+#define ESTADISTICA_H
+
+
+/* Macros varias */
+#define MIN_MUESTRAS 5
+#define MAX_MUESTRAS 1000
+
+// Una muestra se descarta como atípica si se aleja de la mediana más de este
+// número de desviaciones absolutas medianas (escaladas a la desviación
+// típica)
+#define UMBRAL_ATIPICOS 5.0
+
+
+/* Estadísticos de las muestras de una medida, en ciclos por acceso */
+struct Estadisticas
+{
+    double minimo;
+    double mediana;
+    double p90;
+    double p99;
+
+    // Media y desviación típica de las muestras no descartadas
+    double media;
+    double desviacion;
+
+    // Semiamplitud relativa del intervalo de confianza del 95 % de la media
+    double confianza;
+
+    int numMuestras;
+    int numAtipicas;
+};
+
+
+/* Prototipos de las funciones a emplear */
+void calcularEstadisticas( const double *muestras, int numMuestras,
+    struct Estadisticas *estadisticas );
+
+
+#endif
@@ -0,0 +1,251 @@
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <stdint.h>
+#include <cpuid.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+
+#include "eventos.h"
+
+
+/*
+Contadores hardware mediante la llamada al sistema perf_event_open, sin
+depender de libpfm. Los eventos se abren como un único grupo, de modo que se
+activan y detienen a la vez y sus cuentas corresponden al mismo intervalo;
+solo se cuenta en modo usuario, lo que basta con perf_event_paranoid = 2. Si
+el núcleo no permite abrir ninguno (máquinas virtuales sin PMU, paranoid = 3,
+seccomp...), se avisa una vez y las medidas siguen solo con rdtsc.
+*/
+
+
+/* Macros varias */
+
+// Eventos crudos de fallos en la L2, que no tiene evento genérico:
+// L2_RQSTS.MISS en Intel y L2CacheReqStat.LsRdBlkC en AMD
+#define L2_FALLOS_INTEL 0x3F24
+#define L2_FALLOS_AMD 0x0864
+
+// Evento genérico de caché: caché | operación << 8 | resultado << 16
+#define EVENTO_CACHE( cache ) ( ( cache ) | \
+    ( PERF_COUNT_HW_CACHE_OP_READ << 8 ) | \
+    ( PERF_COUNT_HW_CACHE_RESULT_MISS << 16 ) )
+
+
+const char *nombresEventos[ NUM_EVENTOS ] =
+{
+    [ EVENTO_CICLOS ] = "ciclos_nucleo",
+    [ EVENTO_FALLOS_L1D ] = "fallos_l1d",
+    [ EVENTO_FALLOS_L2 ] = "fallos_l2",
+    [ EVENTO_FALLOS_LLC ] = "fallos_llc",
+    [ EVENTO_FALLOS_DTLB ] = "fallos_dtlb"
+};
+
+
+// Descriptor de cada evento (-1 si no se ha podido abrir), del líder del
+// grupo, y posición de cada evento en la lectura conjunta
+static int descriptores[ NUM_EVENTOS ] = { -1, -1, -1, -1, -1 };
+static int lider = -1;
+static int posiciones[ NUM_EVENTOS ];
+static int numAbiertos = 0;
+
+
+/* Obtiene el código del evento crudo de fallos en la L2 según el fabricante,
+   o 0 si no se conoce */
+static unsigned long long eventoL2( void )
+{
+    unsigned eax, ebx, ecx, edx;
+
+
+    if( !__get_cpuid( 0, &eax, &ebx, &ecx, &edx ) )
+    {
+        return( 0 );
+    }
+
+    // "GenuineIntel" y "AuthenticAMD" se reparten entre ebx, edx y ecx
+    if( memcmp( &ebx, "Genu", 4 ) == 0 )
+    {
+        return( L2_FALLOS_INTEL );
+    }
+
+    if( memcmp( &ebx, "Auth", 4 ) == 0 )
+    {
+        return( L2_FALLOS_AMD );
+    }
+
+    return( 0 );
+}
+
+
+/* Rellena la descripción del evento indicado; devuelve 0 si no existe en
+   esta CPU */
+static int describirEvento( int evento, struct perf_event_attr *atributos )
+{
+    memset( atributos, 0, sizeof( struct perf_event_attr ) );
+    atributos->size = sizeof( struct perf_event_attr );
+    atributos->exclude_kernel = 1;
+    atributos->exclude_hv = 1;
+    atributos->read_format = PERF_FORMAT_GROUP |
+        PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+    switch( evento )
+    {
+        case EVENTO_CICLOS:
+            atributos->type = PERF_TYPE_HARDWARE;
+            atributos->config = PERF_COUNT_HW_CPU_CYCLES;
+            break;
+
+        case EVENTO_FALLOS_L1D:
+            atributos->type = PERF_TYPE_HW_CACHE;
+            atributos->config = EVENTO_CACHE( PERF_COUNT_HW_CACHE_L1D );
+            break;
+
+        case EVENTO_FALLOS_L2:
+            atributos->type = PERF_TYPE_RAW;
+            atributos->config = eventoL2();
+            break;
+
+        case EVENTO_FALLOS_LLC:
+            atributos->type = PERF_TYPE_HW_CACHE;
+            atributos->config = EVENTO_CACHE( PERF_COUNT_HW_CACHE_LL );
+            break;
+
+        case EVENTO_FALLOS_DTLB:
+            atributos->type = PERF_TYPE_HW_CACHE;
+            atributos->config = EVENTO_CACHE( PERF_COUNT_HW_CACHE_DTLB );
+            break;
+    }
+
+    return( atributos->type != PERF_TYPE_RAW || atributos->config != 0 );
+}
+
+
+int abrirEventos( FILE *salida )
+{
+    struct perf_event_attr atributos;
+
+    // Error del primer evento que no se ha podido abrir
+    int error;
+
+    // Contador
+    int i;
+
+
+    for( i = 0, error = 0; i < NUM_EVENTOS; i++ )
+    {
+        if( !describirEvento( i, &atributos ) )
+        {
+            continue;
+        }
+
+        // El líder se crea desactivado; el resto lo sigue
+        atributos.disabled = lider == -1;
+
+        descriptores[ i ] = ( int )syscall( SYS_perf_event_open, &atributos,
+            0, -1, lider, 0 );
+
+        if( descriptores[ i ] == -1 )
+        {
+            error = error != 0 ? error : errno;
+            continue;
+        }
+
+        lider = lider == -1 ? descriptores[ i ] : lider;
+        posiciones[ i ] = numAbiertos++;
+    }
+
+    if( lider == -1 )
+    {
+        fprintf( salida, "Contadores hardware no disponibles (%s); se mide "
+            "solo con rdtsc\n", strerror( error ) );
+        return( 0 );
+    }
+
+    for( i = 0; i < NUM_EVENTOS; i++ )
+    {
+        if( descriptores[ i ] == -1 )
+        {
+            fprintf( salida, "Evento %s no disponible\n", nombresEventos[ i ] );
+        }
+    }
+
+    return( 1 );
+}
+
+
+int eventoDisponible( int evento )
+{
+    return( descriptores[ evento ] != -1 );
+}
+
+
+void iniciarEventos( void )
+{
+    if( lider == -1 )
+    {
+        return;
+    }
+
+    ioctl( lider, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP );
+    ioctl( lider, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP );
+}
+
+
+int detenerEventos( double *cuentas )
+{
+    // Número de eventos, tiempos activo y contando, y cuentas, según
+    // PERF_FORMAT_GROUP
+    uint64_t lectura[ 3 + NUM_EVENTOS ];
+
+    // Contador
+    int i;
+
+
+    if( lider == -1 )
+    {
+        return( 0 );
+    }
+
+    ioctl( lider, PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP );
+
+    // Si el grupo no ha llegado a contar (no cabe en los contadores de la
+    // CPU), la repetición no aporta cuentas
+    if( read( lider, lectura, sizeof( lectura ) ) <= 0 || lectura[ 2 ] == 0 )
+    {
+        return( 0 );
+    }
+
+    // Si se ha multiplexado con otros grupos, se escala al tiempo activo
+    for( i = 0; i < NUM_EVENTOS; i++ )
+    {
+        cuentas[ i ] = descriptores[ i ] == -1 ? 0 :
+            ( double )lectura[ 3 + posiciones[ i ] ] * lectura[ 1 ] /
+            lectura[ 2 ];
+    }
+
+    return( 1 );
+}
+
+
+void cerrarEventos( void )
+{
+    // Contador
+    int i;
+
+
+    for( i = 0; i < NUM_EVENTOS; i++ )
+    {
+        if( descriptores[ i ] != -1 )
+        {
+            close( descriptores[ i ] );
+            descriptores[ i ] = -1;
+        }
+    }
+
+    lider = -1;
+    numAbiertos = 0;
+}
@@ -0,0 +1,31 @@
+#ifndef EVENTOS_H
+#define EVENTOS_H
+
+#include <stdio.h>
+
+
+/* Eventos hardware contados junto a los ciclos de rdtsc, en un mismo grupo
+   de perf_event_open */
+enum Evento
+{
+    EVENTO_CICLOS,      // Ciclos del núcleo (a la frecuencia real)
+    EVENTO_FALLOS_L1D,  // Fallos de lectura en la L1 de datos
+    EVENTO_FALLOS_L2,   // Fallos en la L2 (evento propio de cada fabricante)
+    EVENTO_FALLOS_LLC,  // Fallos de lectura en el último nivel
+    EVENTO_FALLOS_DTLB, // Fallos de lectura en la TLB de datos
+    NUM_EVENTOS
+};
+
+
+extern const char *nombresEventos[ NUM_EVENTOS ];
+
+
+/* Prototipos de las funciones a emplear */
+int abrirEventos( FILE *salida );
+int eventoDisponible( int evento );
+void iniciarEventos( void );
+int detenerEventos( double *cuentas );
+void cerrarEventos( void );
+
+
+#endif
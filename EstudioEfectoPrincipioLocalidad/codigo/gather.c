@@ -0,0 +1,166 @@
+#include <immintrin.h>
+
+#include "gather.h"
+
+
+/*
+Variantes vectoriales del bucle de junto.c: los índices de e[] se cargan de
+8 en 8 (o de 4 en 4) y una única instrucción gather trae los elementos de A
+correspondientes. Se emplean cuatro acumuladores vectoriales independientes
+para que la latencia de la suma no limite el bucle. Cada función se compila
+para su conjunto de instrucciones mediante el atributo target, de modo que el
+resto del programa no requiere -mavx2 y la variante se elige en ejecución.
+Cada bucle se instancia mediante una macro para índices de 32 y de 64 bits,
+cambiando la carga de los índices y la instrucción gather correspondiente.
+*/
+
+
+/* Carga de los índices a partir de e[ j ] y gather de los elementos de A */
+#define GATHER256_32( INDICES ) _mm256_i32gather_pd( valoresA, \
+    _mm_loadu_si128( ( const __m128i * )( INDICES ) ), 8 )
+#define GATHER256_64( INDICES ) _mm256_i64gather_pd( valoresA, \
+    _mm256_loadu_si256( ( const __m256i * )( INDICES ) ), 8 )
+#define GATHER512_32( INDICES ) _mm512_i32gather_pd( _mm256_loadu_si256( \
+    ( const __m256i * )( INDICES ) ), valoresA, 8 )
+#define GATHER512_64( INDICES ) _mm512_i64gather_pd( _mm512_loadu_si512( \
+    INDICES ), valoresA, 8 )
+
+
+#define NUCLEO_GATHER256( NOMBRE, TIPO, GATHER ) \
+__attribute__(( target( "avx2" ) )) \
+static void NOMBRE( const struct Medida *medida, double *valoresS ) \
+{ \
+    const double *valoresA = medida->valoresA; \
+    const TIPO *e = medida->e; \
+    long R = medida->R; \
+    \
+    /* Acumuladores vectoriales de 4 doubles */ \
+    __m256d suma0, suma1, suma2, suma3; \
+    \
+    double parcial[ 4 ]; \
+    double suma; \
+    long j; \
+    int i; \
+    \
+    \
+    for( i = 0; i < NUM_S; i++ ) \
+    { \
+        suma0 = _mm256_setzero_pd(); \
+        suma1 = _mm256_setzero_pd(); \
+        suma2 = _mm256_setzero_pd(); \
+        suma3 = _mm256_setzero_pd(); \
+        \
+        /* Cada iteración trae 16 elementos mediante cuatro gathers */ \
+        for( j = 0; j + 16 <= R; j += 16 ) \
+        { \
+            suma0 = _mm256_add_pd( suma0, GATHER( e + j ) ); \
+            suma1 = _mm256_add_pd( suma1, GATHER( e + j + 4 ) ); \
+            suma2 = _mm256_add_pd( suma2, GATHER( e + j + 8 ) ); \
+            suma3 = _mm256_add_pd( suma3, GATHER( e + j + 12 ) ); \
+        } \
+        \
+        /* Se reducen los acumuladores a un único valor */ \
+        suma0 = _mm256_add_pd( _mm256_add_pd( suma0, suma1 ), \
+            _mm256_add_pd( suma2, suma3 ) ); \
+        _mm256_storeu_pd( parcial, suma0 ); \
+        suma = parcial[ 0 ] + parcial[ 1 ] + parcial[ 2 ] + parcial[ 3 ]; \
+        \
+        /* Y se suman de forma escalar los elementos restantes */ \
+        for( ; j < R; j++ ) \
+        { \
+            suma += valoresA[ e[ j ] ]; \
+        } \
+        \
+        valoresS[ i ] = suma; \
+    } \
+}
+
+
+#define NUCLEO_GATHER512( NOMBRE, TIPO, GATHER ) \
+__attribute__(( target( "avx512f" ) )) \
+static void NOMBRE( const struct Medida *medida, double *valoresS ) \
+{ \
+    const double *valoresA = medida->valoresA; \
+    const TIPO *e = medida->e; \
+    long R = medida->R; \
+    \
+    /* Acumuladores vectoriales de 8 doubles */ \
+    __m512d suma0, suma1, suma2, suma3; \
+    \
+    double suma; \
+    long j; \
+    int i; \
+    \
+    \
+    for( i = 0; i < NUM_S; i++ ) \
+    { \
+        suma0 = _mm512_setzero_pd(); \
+        suma1 = _mm512_setzero_pd(); \
+        suma2 = _mm512_setzero_pd(); \
+        suma3 = _mm512_setzero_pd(); \
+        \
+        /* Cada iteración trae 32 elementos mediante cuatro gathers */ \
+        for( j = 0; j + 32 <= R; j += 32 ) \
+        { \
+            suma0 = _mm512_add_pd( suma0, GATHER( e + j ) ); \
+            suma1 = _mm512_add_pd( suma1, GATHER( e + j + 8 ) ); \
+            suma2 = _mm512_add_pd( suma2, GATHER( e + j + 16 ) ); \
+            suma3 = _mm512_add_pd( suma3, GATHER( e + j + 24 ) ); \
+        } \
+        \
+        suma0 = _mm512_add_pd( _mm512_add_pd( suma0, suma1 ), \
+            _mm512_add_pd( suma2, suma3 ) ); \
+        suma = _mm512_reduce_add_pd( suma0 ); \
+        \
+        for( ; j < R; j++ ) \
+        { \
+            suma += valoresA[ e[ j ] ]; \
+        } \
+        \
+        valoresS[ i ] = suma; \
+    } \
+}
+
+
+NUCLEO_GATHER256( nucleoGather256x32, int, GATHER256_32 )
+NUCLEO_GATHER256( nucleoGather256x64, long, GATHER256_64 )
+NUCLEO_GATHER512( nucleoGather512x32, int, GATHER512_32 )
+NUCLEO_GATHER512( nucleoGather512x64, long, GATHER512_64 )
+
+
+int disponibleAVX2( void )
+{
+    return( __builtin_cpu_supports( "avx2" ) );
+}
+
+
+int disponibleAVX512( void )
+{
+    return( __builtin_cpu_supports( "avx512f" ) );
+}
+
+
+void nucleoGather256( const struct Medida *medida, double *valoresS )
+{
+    if( medida->anchoIndices == 64 )
+    {
+        nucleoGather256x64( medida, valoresS );
+    }
+    else
+    {
+        nucleoGather256x32( medida, valoresS );
+    }
+}
+
+
+void nucleoGather512( const struct Medida *medida, double *valoresS )
+{
+    if( medida->anchoIndices == 64 )
+    {
+        nucleoGather512x64( medida, valoresS );
+    }
+    else
+    {
+        nucleoGather512x32( medida, valoresS );
+    }
+}
@@ -0,0 +1,14 @@
+#ifndef GATHER_H
+#define GATHER_H
+
+#include "modos.h"
+
+
+/* Prototipos de las funciones a emplear */
+int disponibleAVX2( void );
+int disponibleAVX512( void );
+void nucleoGather256( const struct Medida *medida, double *valoresS );
+void nucleoGather512( const struct Medida *medida, double *valoresS );
+
+
+#endif
@@ -0,0 +1,173 @@
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sched.h>
+#include <unistd.h>
+#include <omp.h>
+
+#include "contador.h"
+#include "hilos.h"
+
+
+/*
+Reducción con paso D (la de directo.c) ejecutada a la vez por varios hilos,
+cada uno fijado a un core distinto. Cada hilo recorre su propia copia del
+vector A (reservada y escrita por él mismo, de modo que quede en su nodo de
+memoria) o todos recorren el vector A común. Así se observa a partir de
+cuántos cores se satura la caché compartida o el controlador de memoria.
+*/
+
+
+int coresPermitidos( int *cores )
+{
+    // Afinidad del proceso, que puede estar restringida (taskset, cgroups)
+    cpu_set_t afinidad;
+    int numCores;
+    int i;
+
+
+    if( sched_getaffinity( 0, sizeof( cpu_set_t ), &afinidad ) != 0 )
+    {
+        perror( "Lectura de la afinidad fallida" );
+        exit( EXIT_FAILURE );
+    }
+
+    // Se devuelven, en orden, los cores en los que se puede ejecutar
+    for( i = 0, numCores = 0; i < CPU_SETSIZE && numCores < MAX_HILOS; i++ )
+    {
+        if( CPU_ISSET( i, &afinidad ) )
+        {
+            cores[ numCores++ ] = i;
+        }
+    }
+
+    return( numCores );
+}
+
+
+int numeroCores( void )
+{
+    int cores[ MAX_HILOS ];
+
+
+    return( coresPermitidos( cores ) );
+}
+
+
+int medirHilos( const struct Medida *medida, const struct Arena *arena,
+    size_t TC, int numHilos, int compartido, int calentamiento,
+    double sobrecarga, double *ciclosHilos, double *ciclosTotales )
+{
+    // Instantes de inicio y fin de cada hilo
+    unsigned long long inicios[ MAX_HILOS ];
+    unsigned long long finales[ MAX_HILOS ];
+
+    // Afinidad del hilo principal, que se restaura al terminar
+    cpu_set_t afinidadOriginal;
+
+    // Cores permitidos al proceso, a los que se fijan los hilos
+    int cores[ MAX_HILOS ];
+    int numCores;
+
+    // Hilos que crea realmente OpenMP
+    int obtenidos;
+
+    unsigned long long inicio;
+    unsigned long long final;
+    int i;
+
+
+    numCores = coresPermitidos( cores );
+
+    // Sin ajuste dinámico OpenMP crea los hilos pedidos, salvo que lo impida
+    // OMP_THREAD_LIMIT; en tal caso se devuelve cuántos ha creado
+    omp_set_dynamic( 0 );
+    obtenidos = numHilos;
+
+    sched_getaffinity( 0, sizeof( cpu_set_t ), &afinidadOriginal );
+
+    #pragma omp parallel num_threads( numHilos )
+    {
+        // Copia de la medida con el vector A que recorre este hilo
+        struct Medida propia;
+
+        double valoresS[ NUM_S ];
+        cpu_set_t afinidad;
+        int hilo;
+        int k;
+
+
+        hilo = omp_get_thread_num();
+
+        #pragma omp single
+        obtenidos = omp_get_num_threads();
+
+        // Se fija el hilo a uno de los cores permitidos
+        CPU_ZERO( &afinidad );
+        CPU_SET( cores[ hilo % numCores ], &afinidad );
+        sched_setaffinity( 0, sizeof( cpu_set_t ), &afinidad );
+
+        propia = *medida;
+
+        if( !compartido )
+        {
+            // El propio hilo reserva y escribe su copia (primer contacto)
+            if( ( propia.valoresA = reservarBloque( arena->reserva, TC *
+                sizeof( double ), arena->alineamiento ) ) == NULL )
+            {
+                perror( "Reserva de memoria fallida" );
+                exit( EXIT_FAILURE );
+            }
+
+            memcpy( propia.valoresA, medida->valoresA, TC *
+                sizeof( double ) );
+        }
+
+        for( k = 0; k < calentamiento; k++ )
+        {
+            modos[ MODO_DIRECTO ].nucleo( &propia, valoresS );
+        }
+
+        // Todos los hilos comienzan a la vez; si faltan hilos no se mide
+        #pragma omp barrier
+
+        if( obtenidos == numHilos )
+        {
+            inicios[ hilo ] = leerCiclos();
+            modos[ MODO_DIRECTO ].nucleo( &propia, valoresS );
+            finales[ hilo ] = leerCiclos();
+        }
+
+        if( !compartido )
+        {
+            liberarBloque( arena->reserva, propia.valoresA, TC *
+                sizeof( double ) );
+        }
+    }
+
+    sched_setaffinity( 0, sizeof( cpu_set_t ), &afinidadOriginal );
+
+    if( obtenidos != numHilos )
+    {
+        return( obtenidos );
+    }
+
+    // Ciclos por acceso de cada hilo, y del conjunto: tiempo entre el primer
+    // inicio y el último final entre el total de accesos de todos los hilos;
+    // como en medir, se descuenta la sobrecarga de la pareja de lecturas
+    for( i = 0, inicio = inicios[ 0 ], final = finales[ 0 ]; i < numHilos;
+        i++ )
+    {
+        ciclosHilos[ i ] = ( ( double )( finales[ i ] - inicios[ i ] ) -
+            sobrecarga ) / ( ( double )NUM_S * medida->R );
+
+        inicio = inicios[ i ] < inicio ? inicios[ i ] : inicio;
+        final = finales[ i ] > final ? finales[ i ] : final;
+    }
+
+    *ciclosTotales = ( ( double )( final - inicio ) - sobrecarga ) /
+        ( ( double )NUM_S * medida->R * numHilos );
+
+    return( obtenidos );
+}
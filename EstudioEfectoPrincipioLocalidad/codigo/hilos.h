@@ -0,0 +1,20 @@
+#ifndef HILOS_H
+#define HILOS_H
+
+#include "memoria.h"
+#include "modos.h"
+
+
+/* Macros varias */
+#define MAX_HILOS 256
+
+
+/* Prototipos de las funciones a emplear */
+int coresPermitidos( int *cores );
+int numeroCores( void );
+int medirHilos( const struct Medida *medida, const struct Arena *arena,
+    size_t TC, int numHilos, int compartido, int calentamiento,
+    double sobrecarga, double *ciclosHilos, double *ciclosTotales );
+
+
+#endif
@@ -0,0 +1,86 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "latencia.h"
+
+
+/*
+Medida de la latencia de carga a uso: cada nodo de la cadena ocupa una línea
+caché completa y contiene, en su primera palabra, la dirección del siguiente.
+Como cada acceso depende del anterior, la ejecución fuera de orden no puede
+solapar los fallos, y los ciclos por acceso son la latencia del nivel en el
+que quepa la cadena.
+*/
+
+
+void construirCadena( void **nodos, long numNodos, int tamLinea )
+{
+    // Punteros que caben en una línea; separación entre nodos consecutivos
+    int punterosLinea;
+
+    // Orden en el que se visitan los nodos
+    long *orden;
+
+    long aux;
+    long i;
+    long j;
+
+
+    punterosLinea = tamLinea / sizeof( void * );
+
+    if( ( orden = ( long * )malloc( numNodos * sizeof( long ) ) ) == NULL )
+    {
+        perror( "Reserva de memoria fallida" );
+        exit( EXIT_FAILURE );
+    }
+
+    for( i = 0; i < numNodos; i++ )
+    {
+        orden[ i ] = i;
+    }
+
+    // Se baraja el orden (Fisher-Yates) dejando fijo el nodo 0, que es en el
+    // que comienza el recorrido; una permutación aleatoria impide que la
+    // precarga por hardware adivine el siguiente nodo
+    for( i = numNodos - 1; i > 1; i-- )
+    {
+        j = 1 + rand() % i;
+
+        aux = orden[ i ];
+        orden[ i ] = orden[ j ];
+        orden[ j ] = aux;
+    }
+
+    // Y se enlaza cada nodo con el siguiente de la permutación, cerrando el
+    // ciclo en el nodo 0
+    for( i = 0; i < numNodos; i++ )
+    {
+        nodos[ orden[ i ] * punterosLinea ] =
+            &nodos[ orden[ ( i + 1 ) % numNodos ] * punterosLinea ];
+    }
+
+    free( orden );
+}
+
+
+void nucleoLatencia( const struct Medida *medida, double *valoresS )
+{
+    void **p = medida->nodos;
+    long R = medida->R;
+
+    long j;
+    int i;
+
+
+    for( i = 0; i < NUM_S; i++ )
+    {
+        // Cada salto depende de la carga anterior
+        for( j = 0; j < R; j++ )
+        {
+            p = ( void ** )*p;
+        }
+
+        // Se almacena el nodo alcanzado para que el recorrido no se descarte
+        valoresS[ i ] = ( double )( ( char * )p - ( char * )medida->nodos );
+    }
+}
@@ -0,0 +1,12 @@
+#ifndef LATENCIA_H
+#define LATENCIA_H
+
+#include "modos.h"
+
+
+/* Prototipos de las funciones a emplear */
+void construirCadena( void **nodos, long numNodos, int tamLinea );
+void nucleoLatencia( const struct Medida *medida, double *valoresS );
+
+
+#endif
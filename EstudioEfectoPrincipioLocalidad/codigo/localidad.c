@@ -0,0 +1,1849 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <math.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "acumuladores.h"
+#include "asociatividad.h"
+#include "cache.h"
+#include "carga.h"
+#include "compresion.h"
+#include "contador.h"
+#include "especializados.h"
+#include "eventos.h"
+#include "hilos.h"
+#include "latencia.h"
+#include "memoria.h"
+#include "mlp.h"
+#include "modos.h"
+#include "numa.h"
+#include "patrones.h"
+#include "precarga.h"
+#include "resultados.h"
+#include "salida.h"
+#include "versiones.h"
+
+
+/* Macros varias */
+#define MAX_VALORES_D 64
+#define CALENTAMIENTO 1
+#define MAX_REPETICIONES 50
+#define PRECISION 1.0
+
+// Semilla empleada con la caché en disco si no se indica otra, para que las
+// ejecuciones sucesivas reutilicen el mismo fichero
+#define SEMILLA_DATOS 1
+
+// Tamaño de las páginas base, en bytes
+#define TAM_PAGINA 4096
+
+
+/* Parámetros de la ejecución, obtenidos de la línea de órdenes */
+struct Configuracion
+{
+    // Jerarquía de cachés del equipo
+    struct GeometriaCache geometria;
+
+    // Número de doubles que caben en una línea caché
+    int doublesLinea;
+
+    // Valores D
+    int valoresD[ MAX_VALORES_D ];
+    int numValoresD;
+
+    // Valores L, calculados a partir de la jerarquía de cachés, e índices de
+    // los que se emplean
+    int valoresL[ MAX_VALORES_L ];
+    int numValoresL;
+    int indicesL[ MAX_VALORES_L ];
+    int numIndicesL;
+
+    // Modos de acceso a medir (1 en la posición de cada modo pedido)
+    int seleccion[ NUM_MODOS ];
+
+    // Número de pasadas sin medir previas a cada medida
+    int calentamiento;
+
+    // Anchuras de los índices de e[] a comparar, en bits
+    int anchos[ NUM_ANCHOS ];
+    int numAnchos;
+
+    // Estados de las cachés en los que medir (enum EstadoCache)
+    int estados[ NUM_ESTADOS ];
+    int numEstados;
+
+    // Máximo de repeticiones cronometradas por medida, y semiamplitud
+    // relativa (en tanto por uno) del intervalo de confianza con la que se
+    // deja de repetir
+    int maxRepeticiones;
+    double precision;
+
+    // Distancias y pistas de precarga a barrer en los modos que la admiten
+    int distancias[ MAX_DISTANCIAS ];
+    int numDistancias;
+    int pistas[ NUM_PISTAS ];
+    int numPistas;
+
+    // Patrones de acceso del modo patron
+    struct Patron patrones[ MAX_PATRONES ];
+    int numPatrones;
+
+    // Formas de reservar la memoria a comparar
+    int memorias[ NUM_MEMORIAS ];
+    int numMemorias;
+
+    // Colocaciones NUMA a comparar
+    int colocaciones[ NUM_COLOCACIONES ];
+    int numColocaciones;
+
+    // Número máximo de hilos del modo multihilo
+    int maxHilos;
+
+    // Número máximo de cadenas independientes del modo mlp
+    int maxCadenas;
+
+    // Números de acumuladores del modo acumuladores (ARBOL para la
+    // reducción en árbol)
+    int acumuladores[ MAX_ACUMULADORES + 1 ];
+    int numAcumuladores;
+
+    // Codificaciones de e[] del modo comprimido (enum Codificacion)
+    int codificaciones[ NUM_CODIFICACIONES ];
+    int numCodificaciones;
+
+    // Desenrollados del modo especializado
+    int desenrollados[ MAX_DESENROLLADO ];
+    int numDesenrollados;
+
+    // Versiones de los bucles originales (enum Version); sin ninguna, se
+    // mide sólo el bucle compilado con las opciones de la línea de órdenes
+    int versiones[ NUM_VERSIONES ];
+    int numVersiones;
+
+    // Intensidades, en % del tiempo, de la carga de fondo del modo carga
+    int intensidades[ MAX_INTENSIDADES ];
+    int numIntensidades;
+
+    // Semilla de la generación de datos, y directorio de la caché en disco
+    // del vector A (NULL si no se emplea)
+    unsigned semilla;
+    const char *datos;
+
+    // Formato del fichero de resultados (enum FormatoSalida)
+    int formato;
+
+    // Frecuencia y sobrecarga del contador de ciclos
+    struct Calibracion calibracion;
+};
+
+
+/* Prototipos de las funciones a emplear */
+void leerArgumentos( int argc, char **argv, struct Configuracion *conf );
+int leerLista( const char *texto, int *valores, int maxValores );
+int leerNombres( char *texto, int *valores, int maxValores, int ( *buscar )(
+    const char * ), const char *descripcion );
+long calcularR( int L, int D, int doublesLinea );
+void barrer( const struct Configuracion *conf, struct Arena *arena,
+    struct ListaResultados *lista );
+void medirModo( const struct Configuracion *conf, const struct Arena *arena,
+    int modo, struct Medida *medida, int L, int estado,
+    struct ListaResultados *lista );
+void medir( int modo, const struct Medida *medida, int estado,
+    const struct Configuracion *conf, struct Resultado *resultado );
+void barrerHilos( const struct Configuracion *conf, const struct Arena *arena,
+    int modo, const struct Medida *medida, int L,
+    struct ListaResultados *lista );
+void barrerAsociatividad( const struct Configuracion *conf,
+    const struct Arena *arena, int modo, struct ListaResultados *lista );
+void barrerMlp( const struct Configuracion *conf, const struct Arena *arena,
+    int modo, int L, struct ListaResultados *lista );
+void barrerAcumuladores( const struct Configuracion *conf,
+    const struct Arena *arena, int modo, struct Medida *medida, int L,
+    struct ListaResultados *lista );
+void barrerPatrones( const struct Configuracion *conf,
+    const struct Arena *arena, int modo, struct Medida *medida, int L,
+    struct ListaResultados *lista );
+void barrerComprimidos( const struct Configuracion *conf,
+    const struct Arena *arena, int modo, struct Medida *medida, int L,
+    struct ListaResultados *lista );
+void barrerEspecializados( const struct Configuracion *conf,
+    const struct Arena *arena, int modo, struct Medida *medida, int L,
+    struct ListaResultados *lista );
+void barrerVersiones( const struct Configuracion *conf,
+    const struct Arena *arena, int modo, struct Medida *medida, int L,
+    struct ListaResultados *lista );
+void barrerCarga( const struct Configuracion *conf, const struct Arena *arena,
+    int modo, int L, struct ListaResultados *lista );
+
+
+/* Main */
+int main(int argc, char **argv)
+{
+    /* Variables a emplear */
+
+    // Parámetros de la ejecución
+    struct Configuracion conf;
+
+    // Memoria común a todas las medidas
+    struct Arena arena;
+
+    // TC calculado, y máximos de todos los puntos a medir
+    size_t TC;
+    size_t maxTC;
+    size_t maxR;
+    size_t maxNodos;
+
+    // Valor R
+    long R;
+
+    // Si alguno de los modos pedidos recorre la cadena de punteros
+    int cadena;
+
+    // Resultados de las medidas
+    struct ListaResultados lista;
+
+    // Contadores
+    int i;
+    int j;
+
+    // Fichero en el que guardar el resultado, y descripción de la ejecución
+    // con la línea de órdenes tal cual se recibió
+    FILE *fichero;
+    struct Cabecera cabecera;
+    char **ordenes;
+
+    // Descripción del vector A al comprobar su colocación
+    char descripcion[ 64 ];
+
+
+    /***** Argumentos *****/
+
+    // Se copia la línea de órdenes para la cabecera, ya que strtok escribe
+    // sobre las listas de argv al leerlas
+    if( ( ordenes = malloc( ( argc + 1 ) * sizeof( char * ) ) ) == NULL )
+    {
+        perror( "Reserva de memoria fallida" );
+        exit( EXIT_FAILURE );
+    }
+
+    for( i = 0; i < argc; i++ )
+    {
+        if( ( ordenes[ i ] = strdup( argv[ i ] ) ) == NULL )
+        {
+            perror( "Reserva de memoria fallida" );
+            exit( EXIT_FAILURE );
+        }
+    }
+    ordenes[ argc ] = NULL;
+
+    leerArgumentos( argc, argv, &conf );
+
+    // Si se pide alguna colocación NUMA, se fija el hilo que mide a su core
+    // actual y se obtienen los nodos local y remoto
+    if( conf.numColocaciones > 1 ||
+        conf.colocaciones[ 0 ] != COLOCACION_NINGUNA )
+    {
+        prepararNuma();
+    }
+
+
+    /***** Inicialización *****/
+
+    // Se calibra el contador, obteniendo su frecuencia para expresar
+    // también los resultados en nanosegundos y la sobrecarga a descontar
+    calibrarContador( &conf.calibracion, stdout );
+
+    // Se abre el grupo de contadores hardware; si el núcleo no lo permite,
+    // se mide únicamente con rdtsc
+    abrirEventos( stdout );
+
+    // Se calcula el mayor espacio que requiere cualquiera de los puntos a
+    // medir, de modo que la arena se reserve e inicialice una única vez
+    for( i = 0, cadena = 0; i < NUM_MODOS; i++ )
+    {
+        cadena |= conf.seleccion[ i ] && modos[ i ].cadena;
+    }
+
+    for( j = 0, maxNodos = 0; j < conf.numIndicesL; j++ )
+    {
+        if( cadena &&
+            ( size_t )conf.valoresL[ conf.indicesL[ j ] ] > maxNodos )
+        {
+            maxNodos = conf.valoresL[ conf.indicesL[ j ] ];
+        }
+    }
+
+    for( i = 0, maxTC = 0, maxR = 0; i < conf.numValoresD; i++ )
+    {
+        for( j = 0; j < conf.numIndicesL; j++ )
+        {
+            R = calcularR( conf.valoresL[ conf.indicesL[ j ] ],
+                conf.valoresD[ i ], conf.doublesLinea );
+
+            // Se reserva también memoria para los elementos intermedios,
+            // multiplicando el número de operandos de la suma por el paso,
+            // y el margen que pueden alcanzar los índices desplazados dentro
+            // de ENTORNO
+            TC = ( size_t )( R - 1 ) * conf.valoresD[ i ] + ENTORNO;
+
+            maxTC = TC > maxTC ? TC : maxTC;
+            maxR = ( size_t )R > maxR ? ( size_t )R : maxR;
+        }
+    }
+
+    inicializarResultados( &lista );
+
+
+    /***** Pruebas *****/
+
+    // Se repite el barrido completo con cada forma de reservar memoria y
+    // cada colocación NUMA; la diferencia entre formas de reserva para un
+    // mismo punto es el coste de la TLB, y entre colocaciones el de acceder
+    // a otro nodo
+    for( i = 0; i < conf.numMemorias; i++ )
+    {
+        for( j = 0; j < conf.numColocaciones; j++ )
+        {
+            // Se emplea la misma semilla con todas las formas de reservar
+            // memoria, para que todas midan sobre los mismos datos
+            srand( conf.semilla );
+
+            if( conf.colocaciones[ j ] != COLOCACION_NINGUNA )
+            {
+                fijarPoliticaHilo( conf.colocaciones[ j ] );
+            }
+
+            inicializarArena( &arena, conf.geometria.tamLinea,
+                conf.memorias[ i ], conf.colocaciones[ j ] );
+
+            if( conf.datos != NULL )
+            {
+                usarDatos( &arena, conf.datos, conf.semilla );
+            }
+
+            reservarArena( &arena, maxTC, maxR );
+            reservarCadena( &arena, maxNodos );
+
+            // Se reinicia la secuencia aleatoria, de modo que los índices y
+            // la cadena no dependan de si A se ha generado o leído de disco
+            srand( conf.semilla );
+
+            // Se comprueba dónde han quedado realmente las páginas
+            if( conf.colocaciones[ j ] != COLOCACION_NINGUNA )
+            {
+                snprintf( descripcion, sizeof( descripcion ),
+                    "Vector A (%s/%s)", nombresMemorias[ conf.memorias[ i ] ],
+                    nombresColocaciones[ conf.colocaciones[ j ] ] );
+                comprobarColocacion( arena.valoresA, arena.capacidadA *
+                    sizeof( double ), descripcion, stdout );
+            }
+
+            barrer( &conf, &arena, &lista );
+
+            liberarArena( &arena );
+        }
+    }
+
+
+    /***** Resultados *****/
+
+    // Se abre el archivo, y se escribe la descripción de la ejecución
+    // seguida de sus resultados
+    fichero = abrirSalida( conf.formato );
+
+    cabecera.argc = argc;
+    cabecera.argv = ordenes;
+    cabecera.seleccion = conf.seleccion;
+    cabecera.geometria = &conf.geometria;
+    cabecera.calibracion = &conf.calibracion;
+    cabecera.semilla = conf.semilla;
+    escribirCabecera( fichero, conf.formato, &cabecera );
+
+    escribirResultados( &lista, conf.formato, fichero );
+
+    cerrarSalida( fichero );
+
+    // Se resume, para cada punto medido con precarga, la mejor distancia de
+    // cada pista y su ganancia respecto al bucle sin precarga
+    resumirPrecarga( &lista, stdout );
+
+    // Y, si se han comparado formas de reservar memoria, la diferencia de
+    // cada una respecto a las páginas de 4 KiB
+    resumirMemorias( &lista, stdout );
+
+    // La asociatividad medida en cada nivel
+    resumirAsociatividad( &lista, &conf.geometria, stdout );
+
+    // La ganancia de repartir la reducción entre varios acumuladores
+    resumirAcumuladores( &lista, stdout );
+
+    // El tráfico y el tiempo de cada codificación de los índices
+    resumirComprimidos( &lista, stdout );
+
+    // Qué parte del coste por acceso es sobrecarga del bucle
+    resumirEspecializados( &lista, stdout );
+
+    // Cada versión de los bucles originales frente a la primera pedida
+    resumirVersiones( &lista, stdout );
+
+    // La latencia de cada nivel frente al tráfico de los demás cores
+    resumirCarga( &lista, &conf.geometria, stdout );
+
+    // Cuántos fallos en vuelo admite el core en cada nivel
+    resumirMlp( &lista, stdout );
+
+    // Qué patrones cubren los precargadores hardware
+    resumirPatrones( &lista, stdout );
+
+    // El coste de los índices de 64 bits frente a los de 32
+    resumirIndices( &lista, stdout );
+
+    // El coste de empezar con las cachés frías
+    resumirEstados( &lista, stdout );
+
+    // El coste de escribir frente a leer con el mismo recorrido
+    resumirEscrituras( &lista, stdout );
+
+    // Y la penalización de cada colocación NUMA respecto a la local
+    resumirColocaciones( &lista, stdout );
+
+    // Los fallos por acceso medios de cada modo y nivel, si hay contadores
+    // hardware
+    resumirEventos( &lista, &conf.geometria, stdout );
+
+    cerrarEventos();
+    liberarResultados( &lista );
+
+    for( i = 0; i < argc; i++ )
+    {
+        free( ordenes[ i ] );
+    }
+    free( ordenes );
+
+
+    return( EXIT_SUCCESS );
+}
+
+
+void leerArgumentos( int argc, char **argv, struct Configuracion *conf )
+{
+    // Opción leída de la línea de órdenes
+    int opcion;
+
+    // Paso que cruza el número de páginas iterado, más una línea para que
+    // los accesos no caigan todos en el mismo conjunto de la caché
+    int paginas;
+
+    // Modos leídos de la opción -m
+    int modosPedidos[ NUM_MODOS ];
+    int numModos;
+
+    // Si se ha indicado la semilla con -s
+    int semillaFijada;
+
+    // Contador
+    int i;
+
+
+    // Se obtienen las características de las cachés del equipo y, a partir
+    // de ellas, los valores de L a probar
+    detectarCache( &conf->geometria );
+    conf->numValoresL = calcularValoresL( &conf->geometria, conf->valoresL );
+    conf->doublesLinea = conf->geometria.tamLinea / sizeof( double );
+
+    // Valores por defecto
+    for( i = 0; i < NUM_MODOS; i++ )
+    {
+        conf->seleccion[ i ] = 1;
+    }
+
+    conf->calentamiento = CALENTAMIENTO;
+    conf->maxRepeticiones = MAX_REPETICIONES;
+
+    conf->numEstados = 1;
+    conf->estados[ 0 ] = ESTADO_CALIENTE;
+
+    conf->numAnchos = 1;
+    conf->anchos[ 0 ] = 32;
+    conf->precision = PRECISION / 100;
+
+    conf->numDistancias = 7;
+    for( i = 0; i < conf->numDistancias; i++ )
+    {
+        conf->distancias[ i ] = 1 << i;
+    }
+
+    conf->numPistas = NUM_PISTAS;
+    for( i = 0; i < conf->numPistas; i++ )
+    {
+        conf->pistas[ i ] = i;
+    }
+
+    conf->numPatrones = todosPatrones( conf->patrones );
+
+    conf->numMemorias = 1;
+    conf->memorias[ 0 ] = MEMORIA_MM_MALLOC;
+
+    conf->numColocaciones = 1;
+    conf->colocaciones[ 0 ] = COLOCACION_NINGUNA;
+
+    conf->maxHilos = numeroCores() < MAX_HILOS ? numeroCores() : MAX_HILOS;
+    conf->maxCadenas = MAX_CADENAS;
+
+    conf->numAcumuladores = 0;
+    for( i = 1; i <= MAX_ACUMULADORES; i *= 2 )
+    {
+        conf->acumuladores[ conf->numAcumuladores++ ] = i;
+    }
+    conf->acumuladores[ conf->numAcumuladores++ ] = ARBOL;
+
+    conf->numCodificaciones = NUM_CODIFICACIONES;
+    for( i = 0; i < NUM_CODIFICACIONES; i++ )
+    {
+        conf->codificaciones[ i ] = i;
+    }
+
+    conf->numDesenrollados = MAX_DESENROLLADO;
+    for( i = 0; i < MAX_DESENROLLADO; i++ )
+    {
+        conf->desenrollados[ i ] = i + 1;
+    }
+
+    conf->numVersiones = 0;
+
+    conf->numIntensidades = 3;
+    conf->intensidades[ 0 ] = 25;
+    conf->intensidades[ 1 ] = 50;
+    conf->intensidades[ 2 ] = 100;
+
+    conf->formato = FORMATO_JSON;
+
+    conf->semilla = ( unsigned )time( NULL );
+    conf->datos = NULL;
+    semillaFijada = 0;
+
+    while( ( opcion = getopt( argc, argv,
+        "m:cw:f:r:e:x:p:t:P:a:N:n:k:K:z:u:v:I:s:g:o:" ) ) != -1 )
+    {
+        switch( opcion )
+        {
+            case 'c':
+                // Se muestran las cachés detectadas y los valores de L
+                imprimirCache( &conf->geometria, stdout );
+
+                for( i = 0; i < conf->numValoresL; i++ )
+                {
+                    printf( "L[ %d ] = %d líneas\n", i, conf->valoresL[ i ] );
+                }
+
+                exit( EXIT_SUCCESS );
+
+            case 'm':
+                // Se acepta "todos" para recorrer todos los modos, o una
+                // lista separada por comas
+                if( strcmp( optarg, "todos" ) == 0 )
+                {
+                    break;
+                }
+
+                numModos = leerNombres( optarg, modosPedidos, NUM_MODOS,
+                    buscarModo, "Modo" );
+
+                for( i = 0; i < NUM_MODOS; i++ )
+                {
+                    conf->seleccion[ i ] = 0;
+                }
+
+                for( i = 0; i < numModos; i++ )
+                {
+                    if( !modoDisponible( modosPedidos[ i ] ) )
+                    {
+                        printf( "La CPU no admite el modo %s\n",
+                            modos[ modosPedidos[ i ] ].nombre );
+                        exit( EXIT_FAILURE );
+                    }
+
+                    conf->seleccion[ modosPedidos[ i ] ] = 1;
+                }
+                break;
+
+            case 'w':
+                conf->calentamiento = atoi( optarg );
+                break;
+
+            case 'f':
+                if( strcmp( optarg, "todos" ) == 0 )
+                {
+                    for( i = 0; i < NUM_ESTADOS; i++ )
+                    {
+                        conf->estados[ i ] = i;
+                    }
+
+                    conf->numEstados = NUM_ESTADOS;
+                }
+                else
+                {
+                    conf->numEstados = leerNombres( optarg, conf->estados,
+                        NUM_ESTADOS, buscarEstado, "Estado de caché" );
+                }
+                break;
+
+            case 'r':
+                conf->maxRepeticiones = atoi( optarg );
+                break;
+
+            case 'e':
+                conf->precision = atof( optarg ) / 100;
+                break;
+
+            case 'x':
+                if( strcmp( optarg, "todos" ) == 0 )
+                {
+                    for( i = 0; i < NUM_ANCHOS; i++ )
+                    {
+                        conf->anchos[ i ] = anchosIndices[ i ];
+                    }
+
+                    conf->numAnchos = NUM_ANCHOS;
+                }
+                else
+                {
+                    conf->numAnchos = leerNombres( optarg, conf->anchos,
+                        NUM_ANCHOS, buscarAncho, "Anchura de índices" );
+                }
+                break;
+
+            case 'p':
+                conf->numDistancias = leerLista( optarg, conf->distancias,
+                    MAX_DISTANCIAS );
+                break;
+
+            case 't':
+                conf->numPistas = leerNombres( optarg, conf->pistas,
+                    NUM_PISTAS, buscarPista, "Pista" );
+                break;
+
+            case 'P':
+                if( strcmp( optarg, "todos" ) == 0 )
+                {
+                    conf->numPatrones = todosPatrones( conf->patrones );
+                }
+                else
+                {
+                    conf->numPatrones = leerPatrones( optarg, conf->patrones,
+                        MAX_PATRONES );
+                }
+                break;
+
+            case 'a':
+                if( strcmp( optarg, "todos" ) == 0 )
+                {
+                    for( i = 0; i < NUM_MEMORIAS; i++ )
+                    {
+                        conf->memorias[ i ] = i;
+                    }
+
+                    conf->numMemorias = NUM_MEMORIAS;
+                }
+                else
+                {
+                    conf->numMemorias = leerNombres( optarg, conf->memorias,
+                        NUM_MEMORIAS, buscarMemoria, "Forma de reserva" );
+                }
+                break;
+
+            case 'N':
+                if( strcmp( optarg, "todos" ) == 0 )
+                {
+                    for( i = 1; i < NUM_COLOCACIONES; i++ )
+                    {
+                        conf->colocaciones[ i - 1 ] = i;
+                    }
+
+                    conf->numColocaciones = NUM_COLOCACIONES - 1;
+                }
+                else
+                {
+                    conf->numColocaciones = leerNombres( optarg,
+                        conf->colocaciones, NUM_COLOCACIONES,
+                        buscarColocacion, "Colocación" );
+                }
+                break;
+
+            case 'n':
+                conf->maxHilos = atoi( optarg );
+                break;
+
+            case 'K':
+                conf->numAcumuladores = leerAcumuladores( optarg,
+                    conf->acumuladores, MAX_ACUMULADORES + 1 );
+                break;
+
+            case 'z':
+                if( strcmp( optarg, "todos" ) == 0 )
+                {
+                    for( i = 0; i < NUM_CODIFICACIONES; i++ )
+                    {
+                        conf->codificaciones[ i ] = i;
+                    }
+
+                    conf->numCodificaciones = NUM_CODIFICACIONES;
+                }
+                else
+                {
+                    conf->numCodificaciones = leerNombres( optarg,
+                        conf->codificaciones, NUM_CODIFICACIONES,
+                        buscarCodificacion, "Codificación" );
+                }
+                break;
+
+            case 'u':
+                conf->numDesenrollados = leerLista( optarg,
+                    conf->desenrollados, MAX_DESENROLLADO );
+
+                for( i = 0; i < conf->numDesenrollados; i++ )
+                {
+                    if( conf->desenrollados[ i ] < 1 ||
+                        conf->desenrollados[ i ] > MAX_DESENROLLADO )
+                    {
+                        printf( "El desenrollado debe estar entre 1 y %d\n",
+                            MAX_DESENROLLADO );
+                        exit( EXIT_FAILURE );
+                    }
+                }
+                break;
+
+            case 'v':
+                if( strcmp( optarg, "todos" ) == 0 )
+                {
+                    for( i = 0; i < NUM_VERSIONES; i++ )
+                    {
+                        conf->versiones[ i ] = i;
+                    }
+
+                    conf->numVersiones = NUM_VERSIONES;
+                }
+                else
+                {
+                    conf->numVersiones = leerNombres( optarg,
+                        conf->versiones, NUM_VERSIONES, buscarVersion,
+                        "Versión" );
+                }
+                break;
+
+            case 'I':
+                conf->numIntensidades = leerIntensidades( optarg,
+                    conf->intensidades, MAX_INTENSIDADES );
+                break;
+
+            case 'k':
+                conf->maxCadenas = atoi( optarg );
+
+                if( conf->maxCadenas < 1 || conf->maxCadenas > MAX_CADENAS )
+                {
+                    printf( "El número de cadenas debe estar entre 1 y %d\n",
+                        MAX_CADENAS );
+                    exit( EXIT_FAILURE );
+                }
+                break;
+
+            case 's':
+                conf->semilla = ( unsigned )strtoul( optarg, NULL, 10 );
+                semillaFijada = 1;
+                break;
+
+            case 'o':
+                if( ( conf->formato = buscarFormato( optarg ) ) == -1 )
+                {
+                    printf( "Formato de salida desconocido: %s\n", optarg );
+                    exit( EXIT_FAILURE );
+                }
+                break;
+
+            case 'g':
+                conf->datos = optarg;
+                break;
+
+            default:
+                exit( EXIT_FAILURE );
+        }
+    }
+
+    // Con caché en disco se emplea una semilla fija, salvo que se indique
+    // otra, para que las ejecuciones sucesivas encuentren el fichero
+    if( conf->datos != NULL && !semillaFijada )
+    {
+        conf->semilla = SEMILLA_DATOS;
+    }
+
+    if( argc - optind < 2 )
+    {
+        printf( "Número de valores incorrecto. Uso: %s [-c] [-m modos] "
+            "[-w pasadas] [-f estados] [-r repeticiones] [-e precisión] "
+            "[-x anchuras] [-p distancias] [-t pistas] [-P patrones] "
+            "[-a memorias] [-N colocaciones] [-n hilos] [-k cadenas] "
+            "[-K acumuladores] [-z codificaciones] [-u desenrollados] "
+            "[-v versiones] [-I intensidades] [-s semilla] [-g directorio] "
+            "[-o formato] <D> <L>\n"
+            "D y L admiten listas separadas por comas; D admite además "
+            "\"tlb\" y L \"todos\"\n"
+            "-c muestra las cachés detectadas y los valores de L\n"
+            "-w fija las pasadas de calentamiento previas a cada medida "
+            "(%d por defecto)\n"
+            "-f fija los estados de las cachés al medir (caliente por "
+            "defecto, frio o todos)\n"
+            "-r fija el máximo de repeticiones cronometradas de cada medida "
+            "(%d por defecto, mínimo %d)\n"
+            "-e fija la semiamplitud del intervalo de confianza del 95 %% "
+            "con la que se deja de repetir, en %% de la media (%.1lf por "
+            "defecto)\n"
+            "-x fija las anchuras en bits de los índices de e[] (32 por "
+            "defecto, 64 o todos)\n"
+            "-p y -t fijan las distancias (en iteraciones) y pistas (t0, t1, "
+            "t2, nta) de los modos con precarga por software\n"
+            "-P fija los patrones del modo patron (todos por defecto, o "
+            "lista de nombre[:parámetro])\n"
+            "-a fija las formas de reservar memoria (mm_malloc por defecto, "
+            "thp, hugetlb o todos)\n"
+            "-N fija las colocaciones NUMA (local, remota, entrelazada, "
+            "primer_contacto o todos)\n"
+            "-n fija el número máximo de hilos del modo hilos (tantos como "
+            "cores por defecto)\n"
+            "-k fija el número máximo de cadenas del modo mlp (%d por "
+            "defecto)\n"
+            "-K fija los números de acumuladores del modo acumuladores, de "
+            "1 a %d, o arbol (1,2,4,8,16,arbol por defecto)\n"
+            "-z fija las codificaciones de e[] del modo comprimido (plano, "
+            "delta16, delta8, rle o todos, por defecto)\n"
+            "-u fija los desenrollados del modo especializado (de 1 a %d, "
+            "todos por defecto)\n"
+            "-v mide junto, separado, directo, simple y doble con cada "
+            "versión compilada en el ejecutable (compilada, base, sse3, "
+            "avx2, avx512, cada una también con +pf, o todos)\n"
+            "-I fija las intensidades de la carga de fondo del modo carga, "
+            "en %% del tiempo (25,50,100 por defecto); el modo emplea hasta "
+            "-n - 1 cores de fondo\n"
+            "-s fija la semilla de los datos (la hora actual por defecto, "
+            "%d con -g)\n"
+            "-g guarda el vector A generado en el directorio indicado y lo "
+            "reutiliza en las siguientes ejecuciones con igual semilla y "
+            "tamaño\n"
+            "-o fija el formato de los resultados (json por defecto, en "
+            "resultado.jsonl, o csv, en resultado.csv)\n", argv[ 0 ],
+            CALENTAMIENTO, MAX_REPETICIONES, MIN_MUESTRAS, PRECISION,
+            MAX_CADENAS, MAX_ACUMULADORES, MAX_DESENROLLADO, SEMILLA_DATOS );
+
+        printf( "Modos:" );
+
+        for( i = 0; i < NUM_MODOS; i++ )
+        {
+            printf( " %s", modos[ i ].nombre );
+        }
+
+        printf( ", todos (por defecto)\n" );
+        exit( EXIT_FAILURE );
+    }
+
+    // Se obtienen los valores de D y los índices de L directamente de los
+    // argumentos; "tlb" equivale a pasos que cruzan 1, 2, 4 y 8 páginas de
+    // 4 KiB en cada acceso
+    if( strcmp( argv[ optind ], "tlb" ) == 0 )
+    {
+        for( i = 0, paginas = 1; paginas <= 8; i++, paginas *= 2 )
+        {
+            conf->valoresD[ i ] = paginas * TAM_PAGINA / sizeof( double ) +
+                conf->doublesLinea;
+        }
+
+        conf->numValoresD = i;
+    }
+    else
+    {
+        conf->numValoresD = leerLista( argv[ optind ], conf->valoresD,
+            MAX_VALORES_D );
+    }
+
+    if( strcmp( argv[ optind + 1 ], "todos" ) == 0 )
+    {
+        for( i = 0; i < conf->numValoresL; i++ )
+        {
+            conf->indicesL[ i ] = i;
+        }
+
+        conf->numIndicesL = conf->numValoresL;
+    }
+    else
+    {
+        conf->numIndicesL = leerLista( argv[ optind + 1 ], conf->indicesL,
+            MAX_VALORES_L );
+    }
+
+    for( i = 0; i < conf->numValoresD; i++ )
+    {
+        if( conf->valoresD[ i ] <= 0 )
+        {
+            printf( "D debe ser mayor que 0\n" );
+            exit( EXIT_FAILURE );
+        }
+    }
+
+    for( i = 0; i < conf->numIndicesL; i++ )
+    {
+        if( conf->indicesL[ i ] < 0 ||
+            conf->indicesL[ i ] >= conf->numValoresL )
+        {
+            printf( "L debe estar entre 0 y %d\n", conf->numValoresL - 1 );
+            exit( EXIT_FAILURE );
+        }
+    }
+
+    for( i = 0; i < conf->numDistancias; i++ )
+    {
+        if( conf->distancias[ i ] <= 0 )
+        {
+            printf( "Las distancias de precarga deben ser mayores que 0\n" );
+            exit( EXIT_FAILURE );
+        }
+    }
+
+    if( conf->numValoresD == 0 || conf->numIndicesL == 0 ||
+        conf->calentamiento < 0 || conf->maxRepeticiones < MIN_MUESTRAS ||
+        conf->maxRepeticiones > MAX_MUESTRAS || conf->precision <= 0 ||
+        conf->numDistancias == 0 ||
+        conf->numPistas == 0 || conf->numMemorias == 0 ||
+        conf->numColocaciones == 0 || conf->numEstados == 0 ||
+        conf->numAnchos == 0 || conf->numPatrones == 0 ||
+        conf->numAcumuladores == 0 || conf->numCodificaciones == 0 ||
+        conf->numDesenrollados == 0 || conf->numIntensidades == 0 ||
+        conf->maxHilos <= 0 || conf->maxHilos > MAX_HILOS )
+    {
+        printf( "Valores de D, L, calentamiento, estado, repeticiones, "
+            "precisión, anchura, precarga, patrón, memoria, colocación, "
+            "hilos, acumuladores, codificación, desenrollado o intensidad "
+            "incorrectos\n" );
+        exit( EXIT_FAILURE );
+    }
+}
+
+
+int leerLista( const char *texto, int *valores, int maxValores )
+{
+    // Número de valores leídos
+    int numValores;
+
+    char *fin;
+
+
+    for( numValores = 0; *texto != '\0' && numValores < maxValores; )
+    {
+        valores[ numValores++ ] = strtol( texto, &fin, 10 );
+
+        if( fin == texto || ( *fin != ',' && *fin != '\0' ) )
+        {
+            printf( "Lista de valores incorrecta: %s\n", texto );
+            exit( EXIT_FAILURE );
+        }
+
+        texto = *fin == ',' ? fin + 1 : fin;
+    }
+
+    return( numValores );
+}
+
+
+int leerNombres( char *texto, int *valores, int maxValores, int ( *buscar )(
+    const char * ), const char *descripcion )
+{
+    // Número de valores leídos
+    int numValores;
+
+    char *nombre;
+
+
+    // Se traduce cada nombre de la lista separada por comas a su índice
+    for( numValores = 0, nombre = strtok( texto, "," );
+        nombre != NULL && numValores < maxValores;
+        nombre = strtok( NULL, "," ) )
+    {
+        if( ( valores[ numValores++ ] = buscar( nombre ) ) == -1 )
+        {
+            printf( "%s desconocida: %s\n", descripcion, nombre );
+            exit( EXIT_FAILURE );
+        }
+    }
+
+    return( numValores );
+}
+
+
+long calcularR( int L, int D, int doublesLinea )
+{
+    // Si D no supera el número de doubles por línea, se multiplica el número
+    // de líneas a leer por la cantidad de doubles por línea, y se divide
+    // entre el paso D para saber con cuántos valores se efectuará la
+    // reducción de suma de punto flotante
+    if( D <= doublesLinea )
+    {
+        return( ( long )ceil( ( double )L * doublesLinea / D ) );
+    }
+
+    // En caso contrario, cada acceso cae en una línea distinta
+    return( L );
+}
+
+
+void barrer( const struct Configuracion *conf, struct Arena *arena,
+    struct ListaResultados *lista )
+{
+    // Datos sobre los que trabaja cada medida
+    struct Medida medida;
+
+    // Valores D y L iterados
+    int D;
+    int L;
+
+    // Valor R
+    long R;
+
+    // Contadores
+    int i;
+    int j;
+    int m;
+    int a;
+    int f;
+
+
+    // Los campos que ningún modo fija quedan a cero
+    memset( &medida, 0, sizeof( medida ) );
+    medida.valoresA = arena->valoresA;
+    medida.e = arena->e;
+    medida.nodos = arena->nodos;
+    medida.comprimidos = NULL;
+    medida.version = VERSION_COMPILADA;
+
+    for( i = 0; i < conf->numValoresD; i++ )
+    {
+        D = conf->valoresD[ i ];
+
+        for( j = 0; j < conf->numIndicesL; j++ )
+        {
+            L = conf->valoresL[ conf->indicesL[ j ] ];
+            R = calcularR( L, D, conf->doublesLinea );
+
+            for( m = 0; m < NUM_MODOS; m++ )
+            {
+                // Se descartan los modos no pedidos y los que la CPU no
+                // admite
+                if( !conf->seleccion[ m ] ||
+                    !modoDisponible( m ) )
+                {
+                    continue;
+                }
+
+                if( modos[ m ].asociatividad )
+                {
+                    // Se explora una única vez, con el primer D y L
+                    if( i == 0 && j == 0 )
+                    {
+                        barrerAsociatividad( conf, arena, m, lista );
+                    }
+
+                    continue;
+                }
+
+                if( modos[ m ].mlp )
+                {
+                    // Como la cadena, no depende de D
+                    if( i == 0 )
+                    {
+                        barrerMlp( conf, arena, m, L, lista );
+                    }
+
+                    continue;
+                }
+
+                if( modos[ m ].carga )
+                {
+                    // Como la cadena, no depende de D
+                    if( i == 0 )
+                    {
+                        barrerCarga( conf, arena, m, L, lista );
+                    }
+
+                    continue;
+                }
+
+                if( modos[ m ].cadena )
+                {
+                    // La cadena no depende de D, por lo que sólo se mide con
+                    // el primero de ellos
+                    if( i > 0 )
+                    {
+                        continue;
+                    }
+
+                    // Se enlazan tantos nodos como líneas indica L
+                    medida.R = L;
+                    construirCadena( arena->nodos, L,
+                        conf->geometria.tamLinea );
+                }
+                else
+                {
+                    medida.R = R;
+                }
+
+                medida.D = D;
+                medida.distancia = 0;
+                medida.pista = 0;
+
+                // Los modos de escritura trabajan sobre una copia de A
+                medida.valoresA = modos[ m ].escritura ?
+                    reservarEscritura( arena ) : arena->valoresA;
+
+                if( modos[ m ].hilos )
+                {
+                    barrerHilos( conf, arena, m, &medida, L, lista );
+                    continue;
+                }
+
+                if( modos[ m ].acumuladores )
+                {
+                    barrerAcumuladores( conf, arena, m, &medida, L, lista );
+                    continue;
+                }
+
+                if( modos[ m ].comprimido )
+                {
+                    barrerComprimidos( conf, arena, m, &medida, L, lista );
+                    continue;
+                }
+
+                if( modos[ m ].especializado )
+                {
+                    barrerEspecializados( conf, arena, m, &medida, L, lista );
+                    continue;
+                }
+
+                // Los modos que leen e[] se miden con cada anchura de
+                // índices pedida, y el resto una única vez
+                for( a = 0; a < ( modos[ m ].indices ? conf->numAnchos : 1 );
+                    a++ )
+                {
+                    medida.anchoIndices = modos[ m ].indices ?
+                        conf->anchos[ a ] : 0;
+
+                    if( modos[ m ].indices )
+                    {
+                        // Con 32 bits no se alcanzan más de 2^31 elementos
+                        if( medida.anchoIndices == 32 && ( R - 1 ) * D +
+                            ENTORNO > INT_MAX )
+                        {
+                            fprintf( stderr, "%s D=%d L=%d: los índices de "
+                                "32 bits no alcanzan todo el vector A\n",
+                                modos[ m ].nombre, D, L );
+                            continue;
+                        }
+
+                        // El modo patron genera los índices de cada patrón
+                        if( modos[ m ].patron )
+                        {
+                            barrerPatrones( conf, arena, m, &medida, L,
+                                lista );
+                            continue;
+                        }
+
+                        // Se generan los índices que emplea el modo iterado
+                        generarIndices( arena->e, R, D, modos[ m ].entorno,
+                            medida.anchoIndices );
+                    }
+
+                    // Los bucles originales se miden con cada versión pedida
+                    if( modos[ m ].versiones && conf->numVersiones > 0 )
+                    {
+                        barrerVersiones( conf, arena, m, &medida, L, lista );
+                        continue;
+                    }
+
+                    // Se mide en cada estado de las cachés pedido
+                    for( f = 0; f < conf->numEstados; f++ )
+                    {
+                        medirModo( conf, arena, m, &medida, L,
+                            conf->estados[ f ], lista );
+                    }
+                }
+            }
+        }
+    }
+}
+
+
+void medirModo( const struct Configuracion *conf, const struct Arena *arena,
+    int modo, struct Medida *medida, int L, int estado,
+    struct ListaResultados *lista )
+{
+    struct Resultado *resultado;
+
+    // Contadores
+    int k;
+    int p;
+
+
+    // Se realiza la medida del modo tal cual, que en los modos con precarga
+    // es la referencia sin ella
+    medida->distancia = 0;
+    medida->pista = 0;
+
+    resultado = anadirResultado( lista );
+    resultado->L = L;
+    resultado->D = modos[ modo ].cadena ? 0 : medida->D;
+    resultado->memoria = arena->tipo;
+    resultado->colocacion = arena->colocacion;
+    resultado->estado = estado;
+    resultado->anchoIndices = medida->anchoIndices;
+    medir( modo, medida, estado, conf, resultado );
+
+    if( !modos[ modo ].precarga )
+    {
+        return;
+    }
+
+    // Y, si procede, una medida por cada pista y distancia
+    for( p = 0; p < conf->numPistas; p++ )
+    {
+        for( k = 0; k < conf->numDistancias; k++ )
+        {
+            medida->pista = conf->pistas[ p ];
+            medida->distancia = conf->distancias[ k ];
+
+            resultado = anadirResultado( lista );
+            resultado->L = L;
+            resultado->D = medida->D;
+            resultado->memoria = arena->tipo;
+            resultado->colocacion = arena->colocacion;
+            resultado->estado = estado;
+            resultado->anchoIndices = medida->anchoIndices;
+            resultado->pista = medida->pista;
+            resultado->distancia = medida->distancia;
+            snprintf( resultado->variante, TAM_VARIANTE, "%s/%d",
+                nombresPistas[ medida->pista ], medida->distancia );
+            medir( modo, medida, estado, conf, resultado );
+        }
+    }
+}
+
+
+void barrerAsociatividad( const struct Configuracion *conf,
+    const struct Arena *arena, int modo, struct ListaResultados *lista )
+{
+    // Cadena de K líneas en el mismo conjunto
+    struct Medida medida;
+    void **base;
+
+    const struct NivelCache *nivel;
+    struct Resultado *resultado;
+
+    // Separación entre las líneas (tamaño de una vía) y espacio que ocupan
+    size_t paso;
+    size_t bytes;
+
+    int maxK;
+    int K;
+    int n;
+
+
+    memset( &medida, 0, sizeof( medida ) );
+
+    for( n = 0; n < conf->geometria.numNiveles; n++ )
+    {
+        nivel = &conf->geometria.niveles[ n ];
+        paso = ( size_t )nivel->conjuntos * nivel->tamLinea;
+        maxK = 2 * nivel->vias < MAX_K ? 2 * nivel->vias : MAX_K;
+        bytes = maxK * paso;
+
+        if( ( base = reservarBloque( arena->reserva, bytes,
+            arena->alineamiento ) ) == NULL )
+        {
+            perror( "Reserva de memoria fallida" );
+            exit( EXIT_FAILURE );
+        }
+
+        colocarBloque( base, bytes, arena->colocacion );
+
+        medida.nodos = base;
+        medida.R = ACCESOS_CONJUNTO;
+        medida.D = paso / sizeof( double );
+
+        // Se anota K como L y el paso, en doubles, como D
+        for( K = 1; K <= maxK; K++ )
+        {
+            construirConjunto( base, K, paso );
+
+            resultado = anadirResultado( lista );
+            resultado->L = K;
+            resultado->D = medida.D;
+            resultado->memoria = arena->tipo;
+            resultado->colocacion = arena->colocacion;
+            snprintf( resultado->variante, TAM_VARIANTE, "L%d",
+                nivel->nivel );
+            medir( modo, &medida, ESTADO_CALIENTE, conf, resultado );
+        }
+
+        liberarBloque( arena->reserva, base, bytes );
+    }
+}
+
+
+void barrerMlp( const struct Configuracion *conf, const struct Arena *arena,
+    int modo, int L, struct ListaResultados *lista )
+{
+    struct Medida medida;
+    struct Resultado *resultado;
+
+    // Contadores
+    int n;
+    int f;
+
+
+    memset( &medida, 0, sizeof( medida ) );
+    medida.nodos = arena->nodos;
+
+    // Las L líneas se reparten entre 1 a N cadenas; cada cadena necesita al
+    // menos un nodo
+    for( n = 1; n <= conf->maxCadenas && n <= L; n++ )
+    {
+        medida.numCadenas = n;
+        medida.R = construirCadenas( arena->nodos, L, n,
+            conf->geometria.tamLinea, medida.inicios );
+
+        for( f = 0; f < conf->numEstados; f++ )
+        {
+            resultado = anadirResultado( lista );
+            resultado->L = L;
+            resultado->memoria = arena->tipo;
+            resultado->colocacion = arena->colocacion;
+            resultado->estado = conf->estados[ f ];
+            snprintf( resultado->variante, TAM_VARIANTE, "%d", n );
+            medir( modo, &medida, conf->estados[ f ], conf, resultado );
+        }
+    }
+}
+
+
+void barrerAcumuladores( const struct Configuracion *conf,
+    const struct Arena *arena, int modo, struct Medida *medida, int L,
+    struct ListaResultados *lista )
+{
+    struct Resultado *resultado;
+
+    // Contadores
+    int k;
+    int f;
+
+
+    // El modo no lee e[], que no debe vaciarse con la anchura que haya
+    // dejado el modo anterior
+    medida->anchoIndices = 0;
+
+    for( k = 0; k < conf->numAcumuladores; k++ )
+    {
+        medida->numAcumuladores = conf->acumuladores[ k ];
+
+        for( f = 0; f < conf->numEstados; f++ )
+        {
+            resultado = anadirResultado( lista );
+            resultado->L = L;
+            resultado->D = medida->D;
+            resultado->memoria = arena->tipo;
+            resultado->colocacion = arena->colocacion;
+            resultado->estado = conf->estados[ f ];
+            describirAcumuladores( medida->numAcumuladores,
+                resultado->variante, TAM_VARIANTE );
+            medir( modo, medida, conf->estados[ f ], conf, resultado );
+        }
+    }
+}
+
+
+void barrerPatrones( const struct Configuracion *conf,
+    const struct Arena *arena, int modo, struct Medida *medida, int L,
+    struct ListaResultados *lista )
+{
+    struct Resultado *resultado;
+
+    // Contadores
+    int p;
+    int f;
+
+
+    for( p = 0; p < conf->numPatrones; p++ )
+    {
+        generarPatron( arena->e, medida->R, medida->D, &conf->patrones[ p ],
+            medida->anchoIndices );
+
+        for( f = 0; f < conf->numEstados; f++ )
+        {
+            resultado = anadirResultado( lista );
+            resultado->L = L;
+            resultado->D = medida->D;
+            resultado->memoria = arena->tipo;
+            resultado->colocacion = arena->colocacion;
+            resultado->estado = conf->estados[ f ];
+            resultado->anchoIndices = medida->anchoIndices;
+            describirPatron( &conf->patrones[ p ], resultado->variante,
+                TAM_VARIANTE );
+            medir( modo, medida, conf->estados[ f ], conf, resultado );
+        }
+    }
+}
+
+
+void barrerComprimidos( const struct Configuracion *conf,
+    const struct Arena *arena, int modo, struct Medida *medida, int L,
+    struct ListaResultados *lista )
+{
+    struct Resultado *resultado;
+
+    // Flujo de índices con la codificación iterada
+    struct IndicesComprimidos comprimidos;
+
+    // Patrón de la fuente pagina, con regiones de una página
+    struct Patron pagina = { PATRON_PAGINA, TAM_PAGINA };
+
+    // Contadores
+    int s;
+    int c;
+    int f;
+
+
+    // Se comprimen índices de 32 bits, que deben alcanzar todo el recorrido
+    if( ( medida->R - 1 ) * medida->D + ENTORNO > INT_MAX )
+    {
+        fprintf( stderr, "%s D=%ld L=%d: los índices de 32 bits no alcanzan "
+            "todo el vector A\n", modos[ modo ].nombre, medida->D, L );
+        return;
+    }
+
+    medida->anchoIndices = 0;
+
+    for( s = 0; s < NUM_FUENTES; s++ )
+    {
+        // Con los índices de junto las diferencias son siempre D; con los
+        // de precarga y pagina varían, y delta8 mezcla escapes y diferencias
+        // cortas en un mismo bloque de 8
+        switch( s )
+        {
+            case FUENTE_JUNTO:
+                generarIndices( arena->e, medida->R, medida->D, 0, 32 );
+                break;
+
+            case FUENTE_ENTORNO:
+                generarIndices( arena->e, medida->R, medida->D, 1, 32 );
+                break;
+
+            default:
+                generarPatron( arena->e, medida->R, medida->D, &pagina, 32 );
+                break;
+        }
+
+        for( c = 0; c < conf->numCodificaciones; c++ )
+        {
+            if( !comprimirIndices( arena->e, medida->R,
+                conf->codificaciones[ c ], arena->tipo, arena->alineamiento,
+                &comprimidos ) )
+            {
+                fprintf( stderr, "%s D=%ld L=%d %s: las diferencias no "
+                    "caben en %s\n", modos[ modo ].nombre, medida->D, L,
+                    nombresFuentes[ s ],
+                    nombresCodificaciones[ conf->codificaciones[ c ] ] );
+                continue;
+            }
+
+            medida->comprimidos = &comprimidos;
+
+            for( f = 0; f < conf->numEstados; f++ )
+            {
+                resultado = anadirResultado( lista );
+                resultado->L = L;
+                resultado->D = medida->D;
+                resultado->memoria = arena->tipo;
+                resultado->colocacion = arena->colocacion;
+                resultado->estado = conf->estados[ f ];
+                resultado->bytesIndices = ( double )comprimidos.bytes /
+                    medida->R;
+                snprintf( resultado->variante, TAM_VARIANTE, "%s/%s",
+                    nombresFuentes[ s ],
+                    nombresCodificaciones[ conf->codificaciones[ c ] ] );
+                medir( modo, medida, conf->estados[ f ], conf, resultado );
+            }
+
+            liberarIndicesComprimidos( &comprimidos );
+            medida->comprimidos = NULL;
+        }
+    }
+}
+
+
+void barrerEspecializados( const struct Configuracion *conf,
+    const struct Arena *arena, int modo, struct Medida *medida, int L,
+    struct ListaResultados *lista )
+{
+    struct Resultado *resultado;
+
+    // Contadores
+    int u;
+    int g;
+    int f;
+
+
+    // Cada desenrollado se mide con el núcleo de D fijo, si lo hay, y con
+    // el genérico, que es la referencia
+    // El modo no lee e[], que no debe vaciarse con la anchura que haya
+    // dejado el modo anterior
+    medida->anchoIndices = 0;
+
+    for( u = 0; u < conf->numDesenrollados; u++ )
+    {
+        medida->desenrollado = conf->desenrollados[ u ];
+
+        for( g = pasoEspecializado( medida->D ) ? 0 : 1; g < 2; g++ )
+        {
+            medida->generico = g;
+
+            for( f = 0; f < conf->numEstados; f++ )
+            {
+                resultado = anadirResultado( lista );
+                resultado->L = L;
+                resultado->D = medida->D;
+                resultado->memoria = arena->tipo;
+                resultado->colocacion = arena->colocacion;
+                resultado->estado = conf->estados[ f ];
+                describirEspecializado( medida->desenrollado, g,
+                    resultado->variante, TAM_VARIANTE );
+                medir( modo, medida, conf->estados[ f ], conf, resultado );
+            }
+        }
+    }
+}
+
+
+void barrerVersiones( const struct Configuracion *conf,
+    const struct Arena *arena, int modo, struct Medida *medida, int L,
+    struct ListaResultados *lista )
+{
+    struct Resultado *resultado;
+
+    // Contadores
+    int v;
+    int f;
+
+
+    for( v = 0; v < conf->numVersiones; v++ )
+    {
+        // Se descartan las versiones que la CPU no admite
+        if( !versionDisponible( conf->versiones[ v ] ) )
+        {
+            continue;
+        }
+
+        medida->version = conf->versiones[ v ];
+
+        for( f = 0; f < conf->numEstados; f++ )
+        {
+            resultado = anadirResultado( lista );
+            resultado->L = L;
+            resultado->D = medida->D;
+            resultado->memoria = arena->tipo;
+            resultado->colocacion = arena->colocacion;
+            resultado->estado = conf->estados[ f ];
+            resultado->anchoIndices = medida->anchoIndices;
+            strcpy( resultado->variante,
+                nombresVersiones[ medida->version ] );
+            medir( modo, medida, conf->estados[ f ], conf, resultado );
+        }
+    }
+
+    medida->version = VERSION_COMPILADA;
+}
+
+
+void barrerCarga( const struct Configuracion *conf, const struct Arena *arena,
+    int modo, int L, struct ListaResultados *lista )
+{
+    struct Medida medida;
+    struct Resultado *resultado;
+
+    // Generadores de la carga de fondo y bytes del vector de cada uno
+    struct Carga carga;
+    int maxGeneradores;
+    size_t bytes;
+
+    // Tamaños de la última caché y de la anterior, privada de cada core
+    size_t ultima;
+    size_t privada;
+
+    // Contadores
+    int n;
+    int k;
+    int f;
+
+
+    memset( &medida, 0, sizeof( medida ) );
+    medida.nodos = arena->nodos;
+    medida.R = L;
+    construirCadena( arena->nodos, L, conf->geometria.tamLinea );
+
+    // Un core mide y el resto, hasta -n, generan la carga
+    maxGeneradores = ( conf->maxHilos < numeroCores() ? conf->maxHilos :
+        numeroCores() ) - 1;
+
+    if( maxGeneradores < 1 )
+    {
+        fprintf( stderr, "%s L=%d: no hay más cores, se mide sólo sin "
+            "carga\n", modos[ modo ].nombre, L );
+    }
+
+    ultima = conf->geometria.niveles[ conf->geometria.numNiveles - 1 ].tam;
+    privada = conf->geometria.numNiveles > 1 ? conf->geometria.niveles[
+        conf->geometria.numNiveles - 2 ].tam : ultima;
+
+    for( n = 0; n <= maxGeneradores; n++ )
+    {
+        // Entre todos los generadores recorren el doble de la última caché,
+        // de modo que su tráfico llegue a memoria; con muchos cores la parte
+        // de cada uno cabría en su propia L2 (o la última caché es la de un
+        // CCX), así que cada vector tiene al menos 4 veces la caché privada
+        // y MIN_VECTOR_CARGA
+        bytes = n == 0 ? 0 : 2 * ultima / n;
+        bytes = bytes > 4 * privada ? bytes : 4 * privada;
+        bytes = bytes > MIN_VECTOR_CARGA ? bytes : MIN_VECTOR_CARGA;
+        bytes = n == 0 ? 0 : ( bytes + conf->geometria.tamLinea - 1 ) /
+            conf->geometria.tamLinea * conf->geometria.tamLinea;
+
+        // Sin generadores la intensidad no interviene
+        for( k = 0; k < ( n == 0 ? 1 : conf->numIntensidades ); k++ )
+        {
+            for( f = 0; f < conf->numEstados; f++ )
+            {
+                resultado = anadirResultado( lista );
+                resultado->L = L;
+                resultado->memoria = arena->tipo;
+                resultado->colocacion = arena->colocacion;
+                resultado->estado = conf->estados[ f ];
+
+                if( n == 0 )
+                {
+                    snprintf( resultado->variante, TAM_VARIANTE, "0" );
+                }
+                else
+                {
+                    snprintf( resultado->variante, TAM_VARIANTE, "%d/%d", n,
+                        conf->intensidades[ k ] );
+                }
+
+                iniciarCarga( &carga, n, n == 0 ? 100 :
+                    conf->intensidades[ k ], arena->tipo, bytes,
+                    arena->alineamiento, conf->geometria.tamLinea );
+                medir( modo, &medida, conf->estados[ f ], conf, resultado );
+                resultado->anchoBanda = detenerCarga( &carga,
+                    conf->calibracion.frecuencia );
+            }
+        }
+    }
+}
+
+
+void barrerHilos( const struct Configuracion *conf, const struct Arena *arena,
+    int modo, const struct Medida *medida, int L,
+    struct ListaResultados *lista )
+{
+    // Ciclos por acceso de cada hilo y del conjunto
+    double ciclosHilos[ MAX_HILOS ];
+    double ciclosTotales;
+
+    struct Resultado *resultado;
+
+    // Número de hilos, los que crea realmente OpenMP y si comparten el
+    // vector A
+    int numHilos;
+    int obtenidos;
+    int compartido;
+
+    // Contador
+    int i;
+
+
+    for( numHilos = 1; numHilos <= conf->maxHilos; numHilos++ )
+    {
+        for( compartido = 0; compartido <= 1; compartido++ )
+        {
+            obtenidos = medirHilos( medida, arena, ( size_t )( medida->R -
+                1 ) * medida->D + 1, numHilos, compartido,
+                conf->calentamiento, conf->calibracion.sobrecarga,
+                ciclosHilos, &ciclosTotales );
+
+            // Con menos hilos de los pedidos no se alcanzarán los siguientes
+            if( obtenidos != numHilos )
+            {
+                fprintf( stderr, "%s D=%ld L=%d: OpenMP sólo crea %d de %d "
+                    "hilos (OMP_THREAD_LIMIT); se detiene el barrido\n",
+                    modos[ modo ].nombre, medida->D, L, obtenidos,
+                    numHilos );
+                return;
+            }
+
+            // Una fila para el conjunto de los hilos y otra para cada uno
+            for( i = -1; i < numHilos; i++ )
+            {
+                resultado = anadirResultado( lista );
+                resultado->L = L;
+                resultado->D = medida->D;
+                resultado->modo = modo;
+                resultado->memoria = arena->tipo;
+                resultado->colocacion = arena->colocacion;
+                resultado->ciclos = i == -1 ? ciclosTotales :
+                    ciclosHilos[ i ];
+                resultado->ns = 1e3 * resultado->ciclos /
+                    conf->calibracion.frecuencia;
+
+                // Las ejecuciones multihilo se cronometran una sola vez
+                calcularEstadisticas( &resultado->ciclos, 1,
+                    &resultado->estadisticas );
+
+                if( i == -1 )
+                {
+                    snprintf( resultado->variante, TAM_VARIANTE, "%d/%s",
+                        numHilos, compartido ? "compartido" : "privado" );
+                }
+                else
+                {
+                    snprintf( resultado->variante, TAM_VARIANTE, "%d/%s/%d",
+                        numHilos, compartido ? "compartido" : "privado", i );
+                }
+            }
+        }
+    }
+}
+
+
+void medir( int modo, const struct Medida *medida, int estado,
+    const struct Configuracion *conf, struct Resultado *resultado )
+{
+    double ck;
+
+    // Ciclos por acceso de cada repetición
+    double muestras[ MAX_MUESTRAS ];
+    int numMuestras;
+
+    // Cuentas de los eventos hardware de cada repetición, su suma y número
+    // de repeticiones contadas
+    double cuentas[ NUM_EVENTOS ];
+    double totales[ NUM_EVENTOS ];
+    int numContadas;
+
+    // Valores S
+    double valoresS[ NUM_S ];
+
+    // Contador
+    int i;
+
+
+    // Se recorren los datos sin medir, para que la medida no dependa de lo
+    // que haya dejado en la caché el punto anterior; con las cachés frías
+    // no tiene sentido, ya que se vacían antes de cada repetición
+    for( i = 0; estado == ESTADO_CALIENTE && i < conf->calentamiento; i++ )
+    {
+        modos[ modo ].nucleo( medida, valoresS );
+    }
+
+    for( i = 0; i < NUM_EVENTOS; i++ )
+    {
+        totales[ i ] = 0;
+    }
+
+    // Se cronometra cada repetición por separado hasta que el intervalo de
+    // confianza de la media sea suficientemente estrecho
+    for( numMuestras = 0, numContadas = 0;
+        numMuestras < conf->maxRepeticiones; )
+    {
+        // Se expulsan de todos los niveles de caché los datos que recorre el
+        // núcleo: la cadena o el vector A junto con los índices
+        if( estado == ESTADO_FRIO && modos[ modo ].cadena )
+        {
+            vaciarCache( medida->nodos, ( size_t )medida->R *
+                conf->geometria.tamLinea, conf->geometria.tamLinea );
+        }
+        else if( estado == ESTADO_FRIO )
+        {
+            vaciarCache( medida->valoresA, ( ( size_t )( medida->R - 1 ) *
+                medida->D + ENTORNO ) * sizeof( double ),
+                conf->geometria.tamLinea );
+            vaciarCache( medida->e, ( size_t )medida->R *
+                medida->anchoIndices / 8, conf->geometria.tamLinea );
+
+            if( modos[ modo ].comprimido )
+            {
+                vaciarCache( ( ( const struct IndicesComprimidos * )
+                    medida->comprimidos )->datos, ( ( const struct
+                    IndicesComprimidos * )medida->comprimidos )->reservados,
+                    conf->geometria.tamLinea );
+            }
+        }
+
+        // Se activan los contadores hardware y se registra el contador de
+        // la CPU
+        iniciarEventos();
+        start_counter();
+
+        // Se realizan las sumas especificadas
+        modos[ modo ].nucleo( medida, valoresS );
+
+        // Se registran los ciclos transcurridos desde el registro del
+        // contador
+        ck = get_counter();
+
+        if( detenerEventos( cuentas ) )
+        {
+            for( i = 0; i < NUM_EVENTOS; i++ )
+            {
+                totales[ i ] += cuentas[ i ];
+            }
+
+            numContadas++;
+        }
+
+        muestras[ numMuestras++ ] = ck / ( ( double )modos[ modo ].numSumas *
+            medida->R );
+
+        if( numMuestras >= MIN_MUESTRAS )
+        {
+            calcularEstadisticas( muestras, numMuestras,
+                &resultado->estadisticas );
+
+            if( resultado->estadisticas.confianza <= conf->precision )
+            {
+                break;
+            }
+        }
+    }
+
+    resultado->modo = modo;
+    resultado->ciclos = resultado->estadisticas.mediana;
+    resultado->ns = 1e3 * resultado->ciclos / conf->calibracion.frecuencia;
+
+    // Los eventos se expresan por acceso, igual que los ciclos
+    for( i = 0; i < NUM_EVENTOS && numContadas > 0; i++ )
+    {
+        resultado->eventos[ i ] = eventoDisponible( i ) ? totales[ i ] /
+            ( ( double )modos[ modo ].numSumas * medida->R * numContadas ) :
+            -1;
+    }
+
+    for( i = 0, resultado->suma = 0; i < modos[ modo ].numSumas; i++ )
+    {
+        consumir( valoresS[ i ] );
+        resultado->suma += valoresS[ i ];
+    }
+}
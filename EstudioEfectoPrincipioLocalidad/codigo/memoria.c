@@ -0,0 +1,336 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <math.h>
+#include <pmmintrin.h>
+#include <sys/mman.h>
+
+#include "datos.h"
+#include "memoria.h"
+#include "numa.h"
+
+
+/* Tamaño de las páginas normales y enormes empleadas */
+#define TAM_PAGINA 4096
+#define TAM_PAGINA_ENORME ( 2 * 1024 * 1024 )
+
+#ifndef MAP_HUGE_2MB
+#define MAP_HUGE_2MB ( 21 << 26 )
+#endif
+
+
+const char *nombresMemorias[ NUM_MEMORIAS ] =
+{
+    [ MEMORIA_MM_MALLOC ] = "mm_malloc",
+    [ MEMORIA_THP ] = "thp",
+    [ MEMORIA_HUGETLB ] = "hugetlb"
+};
+
+
+int buscarMemoria( const char *nombre )
+{
+    // Contador
+    int i;
+
+
+    for( i = 0; i < NUM_MEMORIAS; i++ )
+    {
+        if( strcmp( nombresMemorias[ i ], nombre ) == 0 )
+        {
+            return( i );
+        }
+    }
+
+    return( -1 );
+}
+
+
+void generarValores( double *valoresA, size_t inicio, size_t fin )
+{
+    // Contador
+    size_t i;
+
+
+    // Se genera en cada posición un valor entre 1 y 2, con signo aleatorio
+    for( i = inicio; i < fin; i++ )
+    {
+        valoresA[ i ] = ( ( double )rand() / RAND_MAX + 1 ) *
+            pow( -1, rand() % 2 );
+    }
+}
+
+
+/* Redondea al siguiente múltiplo del tamaño de página */
+static size_t redondearPagina( size_t bytes )
+{
+    return( ( bytes + TAM_PAGINA - 1 ) & ~( size_t )( TAM_PAGINA - 1 ) );
+}
+
+
+/* Redondea al siguiente múltiplo del tamaño de página enorme */
+static size_t redondearPaginaEnorme( size_t bytes )
+{
+    return( ( bytes + TAM_PAGINA_ENORME - 1 ) & ~( size_t )( TAM_PAGINA_ENORME
+        - 1 ) );
+}
+
+
+void *reservarBloque( int tipo, size_t bytes, size_t alineamiento )
+{
+    // Región proyectada y su inicio alineado a una página enorme
+    char *region;
+    char *inicio;
+
+    size_t tam;
+
+
+    switch( tipo )
+    {
+        case MEMORIA_THP:
+            // Se proyecta una página enorme de más para poder alinear el
+            // inicio, requisito para que el núcleo emplee páginas enormes
+            tam = redondearPaginaEnorme( bytes );
+            region = mmap( NULL, tam + TAM_PAGINA_ENORME, PROT_READ |
+                PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0 );
+
+            if( region == MAP_FAILED )
+            {
+                return( NULL );
+            }
+
+            // Se descartan los fragmentos anterior y posterior a la zona
+            // alineada
+            inicio = ( char * )redondearPaginaEnorme( ( uintptr_t )region );
+
+            if( inicio > region )
+            {
+                munmap( region, inicio - region );
+            }
+
+            munmap( inicio + tam, region + TAM_PAGINA_ENORME - inicio );
+
+            if( madvise( inicio, tam, MADV_HUGEPAGE ) != 0 )
+            {
+                perror( "madvise( MADV_HUGEPAGE )" );
+            }
+
+            return( inicio );
+
+        case MEMORIA_HUGETLB:
+            // Las proyecciones de páginas enormes ya están alineadas a ellas
+            region = mmap( NULL, redondearPaginaEnorme( bytes ), PROT_READ |
+                PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB |
+                MAP_HUGE_2MB, -1, 0 );
+
+            if( region == MAP_FAILED )
+            {
+                fprintf( stderr, "No hay páginas enormes suficientes; se "
+                    "pueden reservar en /proc/sys/vm/nr_hugepages\n" );
+                return( NULL );
+            }
+
+            return( region );
+
+        case MEMORIA_PAGINAS:
+            // Las proyecciones ya están alineadas a página, más que a línea
+            region = mmap( NULL, redondearPagina( bytes ), PROT_READ |
+                PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0 );
+
+            return( region != MAP_FAILED ? region : NULL );
+
+        default:
+            return( _mm_malloc( bytes, alineamiento ) );
+    }
+}
+
+
+void liberarBloque( int tipo, void *bloque, size_t bytes )
+{
+    if( bloque == NULL )
+    {
+        return;
+    }
+
+    if( tipo == MEMORIA_MM_MALLOC )
+    {
+        _mm_free( bloque );
+    }
+    else if( tipo == MEMORIA_PAGINAS )
+    {
+        munmap( bloque, redondearPagina( bytes ) );
+    }
+    else
+    {
+        munmap( bloque, redondearPaginaEnorme( bytes ) );
+    }
+}
+
+
+void inicializarArena( struct Arena *arena, size_t alineamiento, int tipo,
+    int colocacion )
+{
+    arena->valoresA = NULL;
+    arena->capacidadA = 0;
+    arena->e = NULL;
+    arena->capacidadE = 0;
+    arena->nodos = NULL;
+    arena->capacidadNodos = 0;
+    arena->escrituraA = NULL;
+    arena->capacidadEscritura = 0;
+    arena->alineamiento = alineamiento;
+    arena->tipo = tipo;
+    arena->colocacion = colocacion;
+    arena->reserva = tipo == MEMORIA_MM_MALLOC &&
+        colocacion != COLOCACION_NINGUNA ? MEMORIA_PAGINAS : tipo;
+    arena->datos = NULL;
+    arena->semilla = 0;
+}
+
+
+void usarDatos( struct Arena *arena, const char *directorio,
+    unsigned semilla )
+{
+    arena->datos = directorio;
+    arena->semilla = semilla;
+}
+
+
+void reservarArena( struct Arena *arena, size_t TC, size_t R )
+{
+    // Nuevo vector A
+    double *valoresA;
+
+
+    if( TC > arena->capacidadA )
+    {
+        // Se alinea la reserva al inicio de una línea de la caché
+        if( ( valoresA = reservarBloque( arena->reserva, TC * sizeof( double ),
+            arena->alineamiento ) ) == NULL )
+        {
+            perror( "Reserva de memoria fallida" );
+            exit( EXIT_FAILURE );
+        }
+
+        // Se colocan las páginas antes de escribirlas por primera vez
+        colocarBloque( valoresA, TC * sizeof( double ), arena->colocacion );
+
+        // Se conservan los valores ya generados, de modo que todas las
+        // medidas de la ejecución vean los mismos datos
+        if( arena->valoresA != NULL )
+        {
+            memcpy( valoresA, arena->valoresA, arena->capacidadA *
+                sizeof( double ) );
+            liberarBloque( arena->reserva, arena->valoresA, arena->capacidadA *
+                sizeof( double ) );
+        }
+
+        // Y se genera en cada posición nueva un valor entre 1 y 2; si la
+        // arena está vacía y hay caché en disco, se leen todos de ella
+        if( arena->capacidadA == 0 && arena->datos != NULL )
+        {
+            obtenerDatos( arena->datos, arena->semilla, valoresA, TC );
+        }
+        else
+        {
+            generarValores( valoresA, arena->capacidadA, TC );
+        }
+
+        arena->valoresA = valoresA;
+        arena->capacidadA = TC;
+    }
+
+    if( R > arena->capacidadE )
+    {
+        liberarBloque( arena->reserva, arena->e, arena->capacidadE *
+            sizeof( long ) );
+
+        if( ( arena->e = reservarBloque( arena->reserva, R * sizeof( long ),
+            arena->alineamiento ) ) == NULL )
+        {
+            perror( "Reserva de memoria fallida" );
+            exit( EXIT_FAILURE );
+        }
+
+        colocarBloque( arena->e, R * sizeof( long ), arena->colocacion );
+
+        arena->capacidadE = R;
+    }
+}
+
+
+void reservarCadena( struct Arena *arena, size_t numNodos )
+{
+    // Cada nodo ocupa una línea caché completa
+    if( numNodos > arena->capacidadNodos )
+    {
+        liberarBloque( arena->reserva, arena->nodos, arena->capacidadNodos *
+            arena->alineamiento );
+
+        if( ( arena->nodos = reservarBloque( arena->reserva, numNodos *
+            arena->alineamiento, arena->alineamiento ) ) == NULL )
+        {
+            perror( "Reserva de memoria fallida" );
+            exit( EXIT_FAILURE );
+        }
+
+        colocarBloque( arena->nodos, numNodos * arena->alineamiento,
+            arena->colocacion );
+
+        arena->capacidadNodos = numNodos;
+    }
+}
+
+
+double *reservarEscritura( struct Arena *arena )
+{
+    // La copia tiene el tamaño, la forma de reserva y la colocación del
+    // vector A, de modo que los modos de escritura recorren memoria
+    // equivalente
+    if( arena->capacidadA > arena->capacidadEscritura )
+    {
+        liberarBloque( arena->reserva, arena->escrituraA,
+            arena->capacidadEscritura * sizeof( double ) );
+
+        if( ( arena->escrituraA = reservarBloque( arena->reserva,
+            arena->capacidadA * sizeof( double ),
+            arena->alineamiento ) ) == NULL )
+        {
+            perror( "Reserva de memoria fallida" );
+            exit( EXIT_FAILURE );
+        }
+
+        colocarBloque( arena->escrituraA, arena->capacidadA *
+            sizeof( double ), arena->colocacion );
+
+        arena->capacidadEscritura = arena->capacidadA;
+    }
+
+    // Se parte de los mismos valores que A en cada modo
+    memcpy( arena->escrituraA, arena->valoresA, arena->capacidadA *
+        sizeof( double ) );
+
+    return( arena->escrituraA );
+}
+
+
+void liberarArena( struct Arena *arena )
+{
+    // Se conserva la caché en disco para la siguiente reserva
+    const char *datos = arena->datos;
+    unsigned semilla = arena->semilla;
+
+
+    liberarBloque( arena->reserva, arena->valoresA, arena->capacidadA *
+        sizeof( double ) );
+    liberarBloque( arena->reserva, arena->e, arena->capacidadE *
+        sizeof( long ) );
+    liberarBloque( arena->reserva, arena->nodos, arena->capacidadNodos *
+        arena->alineamiento );
+    liberarBloque( arena->reserva, arena->escrituraA,
+        arena->capacidadEscritura * sizeof( double ) );
+
+    inicializarArena( arena, arena->alineamiento, arena->tipo,
+        arena->colocacion );
+    usarDatos( arena, datos, semilla );
+}
@@ -0,0 +1,84 @@
+#ifndef MEMORIA_H
+#define MEMORIA_H
+
+#include <stddef.h>
+
+
+/* Formas de reservar la memoria de las medidas */
+enum TipoMemoria
+{
+    MEMORIA_MM_MALLOC,  // _mm_malloc, páginas de 4 KiB
+    MEMORIA_THP,        // mmap + madvise( MADV_HUGEPAGE ), páginas enormes
+                        // transparentes si el núcleo las concede
+    MEMORIA_HUGETLB,    // mmap con MAP_HUGETLB, páginas de 2 MiB reservadas
+                        // en /proc/sys/vm/nr_hugepages
+    NUM_MEMORIAS,
+
+    // Sólo interna: mmap con páginas de 4 KiB, en lugar de _mm_malloc cuando
+    // la memoria se coloca en un nodo NUMA
+    MEMORIA_PAGINAS = NUM_MEMORIAS
+};
+
+
+/* Zona de memoria común a todas las medidas de una ejecución; se reutiliza
+   entre puntos (D, L) y sólo crece cuando un punto necesita más espacio */
+struct Arena
+{
+    // Vector A, con valores entre 1 y 2 en cada posición ya inicializada
+    double *valoresA;
+    size_t capacidadA;
+
+    // Vector de índices e; se regenera antes de cada medida, y se reserva
+    // con capacidad para índices de 64 bits
+    void *e;
+    size_t capacidadE;
+
+    // Cadena de punteros del modo de latencia, con un nodo por línea
+    void **nodos;
+    size_t capacidadNodos;
+
+    // Copia del vector A sobre la que escriben los modos de escritura, para
+    // que el resto siga midiendo sobre los mismos datos; se reserva al
+    // medir el primero de ellos
+    double *escrituraA;
+    size_t capacidadEscritura;
+
+    // Alineamiento de las reservas (tamaño de línea caché)
+    size_t alineamiento;
+
+    // Forma de reservar la memoria (enum TipoMemoria) y nodos NUMA en los
+    // que colocarla (enum Colocacion)
+    int tipo;
+    int colocacion;
+
+    // Forma en la que se reservan realmente los bloques: la de tipo, salvo
+    // mm_malloc con una colocación, que se proyecta con mmap para que mbind
+    // no alcance a otros datos del montículo
+    int reserva;
+
+    // Directorio de la caché en disco del vector A (NULL para generarlo
+    // siempre) y semilla con la que se genera
+    const char *datos;
+    unsigned semilla;
+};
+
+
+extern const char *nombresMemorias[ NUM_MEMORIAS ];
+
+
+/* Prototipos de las funciones a emplear */
+int buscarMemoria( const char *nombre );
+void generarValores( double *valoresA, size_t inicio, size_t fin );
+void *reservarBloque( int tipo, size_t bytes, size_t alineamiento );
+void liberarBloque( int tipo, void *bloque, size_t bytes );
+void inicializarArena( struct Arena *arena, size_t alineamiento, int tipo,
+    int colocacion );
+void usarDatos( struct Arena *arena, const char *directorio,
+    unsigned semilla );
+void reservarArena( struct Arena *arena, size_t TC, size_t R );
+void reservarCadena( struct Arena *arena, size_t numNodos );
+double *reservarEscritura( struct Arena *arena );
+void liberarArena( struct Arena *arena );
+
+
+#endif
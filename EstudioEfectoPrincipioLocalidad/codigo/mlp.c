@@ -0,0 +1,189 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "mlp.h"
+
+
+/*
+Medida del paralelismo a nivel de memoria: los nodos de la cadena se
+reparten entre N cadenas independientes, que se recorren a la vez avanzando
+un salto en cada una por iteración. Cada salto sigue dependiendo del
+anterior de su cadena, pero los de cadenas distintas pueden solaparse, de
+modo que los ciclos por acceso bajan con N hasta agotar los fallos que el
+core admite en vuelo (los line fill buffers en la L1).
+
+Como la huella total es la misma para todo N, el nivel de caché en el que
+cabe la cadena no cambia. Cada N se instancia con su propia función, para
+que los punteros de las cadenas estén en registros. x86-64 sólo tiene 16
+registros enteros, así que a partir de 13 cadenas (gcc 12, -O1 y -O2) el
+compilador guarda algunos punteros en la pila: cada salto de esas cadenas
+pasa además por un almacenamiento y una carga reenviada desde él, unos 5
+ciclos más en su propia cadena de dependencias. Frente a un fallo en L3 o
+memoria es poco, y los saltos de cadenas distintas siguen solapándose, de
+modo que el límite de fallos en vuelo (12 line fill buffers en Skylake, 16
+en Golden Cove, más en Zen) sigue viéndose; con la cadena en L1 o L2, en
+cambio, las N por encima de 12 miden sobre todo ese coste. Repartir las
+cadenas entre varias llamadas o en grupos sucesivos no sirve, ya que
+dejarían de recorrerse a la vez.
+*/
+
+
+/* Núcleo de N cadenas; cada una da R / N saltos por suma */
+#define NUCLEO_MLP( nombre, N ) \
+static void nombre( const struct Medida *medida, double *valoresS ) \
+{ \
+    void **p[ N ]; \
+    long saltos = medida->R / N; \
+    long j; \
+    int k; \
+    int i; \
+    \
+    _Pragma( "GCC unroll 32" ) \
+    for( k = 0; k < N; k++ ) \
+    { \
+        p[ k ] = medida->inicios[ k ]; \
+    } \
+    \
+    for( i = 0; i < NUM_S; i++ ) \
+    { \
+        /* Un salto en cada cadena, sin dependencias entre ellas */ \
+        for( j = 0; j < saltos; j++ ) \
+        { \
+            _Pragma( "GCC unroll 32" ) \
+            for( k = 0; k < N; k++ ) \
+            { \
+                p[ k ] = ( void ** )*p[ k ]; \
+            } \
+        } \
+        \
+        /* Se almacenan los nodos alcanzados para que el recorrido no se \
+           descarte */ \
+        valoresS[ i ] = 0; \
+        \
+        _Pragma( "GCC unroll 32" ) \
+        for( k = 0; k < N; k++ ) \
+        { \
+            valoresS[ i ] += ( double )( ( char * )p[ k ] - \
+                ( char * )medida->nodos ); \
+        } \
+    } \
+}
+
+
+NUCLEO_MLP( nucleoMlp1, 1 )
+NUCLEO_MLP( nucleoMlp2, 2 )
+NUCLEO_MLP( nucleoMlp3, 3 )
+NUCLEO_MLP( nucleoMlp4, 4 )
+NUCLEO_MLP( nucleoMlp5, 5 )
+NUCLEO_MLP( nucleoMlp6, 6 )
+NUCLEO_MLP( nucleoMlp7, 7 )
+NUCLEO_MLP( nucleoMlp8, 8 )
+NUCLEO_MLP( nucleoMlp9, 9 )
+NUCLEO_MLP( nucleoMlp10, 10 )
+NUCLEO_MLP( nucleoMlp11, 11 )
+NUCLEO_MLP( nucleoMlp12, 12 )
+NUCLEO_MLP( nucleoMlp13, 13 )
+NUCLEO_MLP( nucleoMlp14, 14 )
+NUCLEO_MLP( nucleoMlp15, 15 )
+NUCLEO_MLP( nucleoMlp16, 16 )
+NUCLEO_MLP( nucleoMlp17, 17 )
+NUCLEO_MLP( nucleoMlp18, 18 )
+NUCLEO_MLP( nucleoMlp19, 19 )
+NUCLEO_MLP( nucleoMlp20, 20 )
+NUCLEO_MLP( nucleoMlp21, 21 )
+NUCLEO_MLP( nucleoMlp22, 22 )
+NUCLEO_MLP( nucleoMlp23, 23 )
+NUCLEO_MLP( nucleoMlp24, 24 )
+NUCLEO_MLP( nucleoMlp25, 25 )
+NUCLEO_MLP( nucleoMlp26, 26 )
+NUCLEO_MLP( nucleoMlp27, 27 )
+NUCLEO_MLP( nucleoMlp28, 28 )
+NUCLEO_MLP( nucleoMlp29, 29 )
+NUCLEO_MLP( nucleoMlp30, 30 )
+NUCLEO_MLP( nucleoMlp31, 31 )
+NUCLEO_MLP( nucleoMlp32, 32 )
+
+
+// Núcleo de cada número de cadenas
+static void ( * const nucleos[ MAX_CADENAS + 1 ] )( const struct Medida *,
+    double * ) =
+{
+    NULL, nucleoMlp1, nucleoMlp2, nucleoMlp3, nucleoMlp4, nucleoMlp5,
+    nucleoMlp6, nucleoMlp7, nucleoMlp8, nucleoMlp9, nucleoMlp10, nucleoMlp11,
+    nucleoMlp12, nucleoMlp13, nucleoMlp14, nucleoMlp15, nucleoMlp16,
+    nucleoMlp17, nucleoMlp18, nucleoMlp19, nucleoMlp20, nucleoMlp21,
+    nucleoMlp22, nucleoMlp23, nucleoMlp24, nucleoMlp25, nucleoMlp26,
+    nucleoMlp27, nucleoMlp28, nucleoMlp29, nucleoMlp30, nucleoMlp31,
+    nucleoMlp32
+};
+
+
+long construirCadenas( void **nodos, long numNodos, int numCadenas,
+    int tamLinea, void ***inicios )
+{
+    // Punteros que caben en una línea; nodos de cada cadena
+    int punterosLinea;
+    long longitud;
+
+    // Orden en el que se visitan los nodos
+    long *orden;
+
+    long aux;
+    long i;
+    long j;
+    int k;
+
+
+    punterosLinea = tamLinea / sizeof( void * );
+
+    // Se emplean los primeros nodos que permiten cadenas de igual longitud,
+    // para que la huella sea exactamente la de R líneas
+    longitud = numNodos / numCadenas;
+    numNodos = longitud * numCadenas;
+
+    if( ( orden = ( long * )malloc( numNodos * sizeof( long ) ) ) == NULL )
+    {
+        perror( "Reserva de memoria fallida" );
+        exit( EXIT_FAILURE );
+    }
+
+    for( i = 0; i < numNodos; i++ )
+    {
+        orden[ i ] = i;
+    }
+
+    // Se baraja el orden (Fisher-Yates), para que la precarga por hardware
+    // no adivine el siguiente nodo de ninguna cadena
+    for( i = numNodos - 1; i > 0; i-- )
+    {
+        j = rand() % ( i + 1 );
+
+        aux = orden[ i ];
+        orden[ i ] = orden[ j ];
+        orden[ j ] = aux;
+    }
+
+    // Cada cadena toma un tramo consecutivo de la permutación, y se cierra
+    // sobre sí misma
+    for( k = 0; k < numCadenas; k++ )
+    {
+        for( i = k * longitud; i < ( k + 1 ) * longitud; i++ )
+        {
+            j = i + 1 < ( k + 1 ) * longitud ? i + 1 : k * longitud;
+            nodos[ orden[ i ] * punterosLinea ] =
+                &nodos[ orden[ j ] * punterosLinea ];
+        }
+
+        inicios[ k ] = &nodos[ orden[ k * longitud ] * punterosLinea ];
+    }
+
+    free( orden );
+
+    return( numNodos );
+}
+
+
+void nucleoMlp( const struct Medida *medida, double *valoresS )
+{
+    nucleos[ medida->numCadenas ]( medida, valoresS );
+}
@@ -0,0 +1,20 @@
+#ifndef MLP_H
+#define MLP_H
+
+#include "modos.h"
+
+
+/* Macros varias */
+
+// Fracción de la mayor aceleración a partir de la cual se considera que el
+// número de cadenas satura el paralelismo de memoria
+#define UMBRAL_SATURACION 0.9
+
+
+/* Prototipos de las funciones a emplear */
+long construirCadenas( void **nodos, long numNodos, int numCadenas,
+    int tamLinea, void ***inicios );
+void nucleoMlp( const struct Medida *medida, double *valoresS );
+
+
+#endif
@@ -0,0 +1,339 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "acumuladores.h"
+#include "compresion.h"
+#include "especializados.h"
+#include "escritura.h"
+#include "gather.h"
+#include "latencia.h"
+#include "mlp.h"
+#include "precarga.h"
+#include "versiones.h"
+#include "modos.h"
+
+
+/* Bucles computacionales de cada modo; se copian a variables locales los
+   campos de la medida para que el compilador no tenga que releerlos. Los
+   bucles que leen e[] se instancian mediante una macro para cada anchura de
+   índices, y la función del modo elige la instancia en ejecución. Los bucles
+   de los programas originales se instancian además una vez por cada versión
+   de enum Version, con sus atributos de compilación */
+
+#define NUCLEO_JUNTO( NOMBRE, ATRIBUTOS, TIPO ) \
+ATRIBUTOS static void NOMBRE( const struct Medida *medida, \
+    double *valoresS ) \
+{ \
+    const double *valoresA = medida->valoresA; \
+    const TIPO *e = medida->e; \
+    long R = medida->R; \
+    \
+    double suma; \
+    long j; \
+    int i; \
+    \
+    \
+    /* Se realizan las sumas especificadas */ \
+    for( i = 0; i < NUM_S; i++ ) \
+    { \
+        /* Se emplean los índices calculados */ \
+        for( j = 0, suma = 0; j < R; j++ ) \
+        { \
+            /* Se realiza el acceso a memoria */ \
+            suma += valoresA[ e[ j ] ]; \
+        } \
+        \
+        /* Se almacena la reducción de punto flotante */ \
+        valoresS[ i ] = suma; \
+    } \
+}
+
+
+#define NUCLEO_SEPARADO( NOMBRE, ATRIBUTOS, TIPO ) \
+ATRIBUTOS static void NOMBRE( const struct Medida *medida, \
+    double *valoresS ) \
+{ \
+    const double *valoresA = medida->valoresA; \
+    const TIPO *e = medida->e; \
+    long R = medida->R; \
+    \
+    double suma; \
+    TIPO indice; \
+    long j; \
+    int i; \
+    \
+    \
+    for( i = 0; i < NUM_S; i++ ) \
+    { \
+        for( j = 0, suma = 0; j < R; j++ ) \
+        { \
+            /* Se obtiene el índice antes de realizar el acceso a memoria */ \
+            indice = e[ j ]; \
+            suma += valoresA[ indice ]; \
+        } \
+        \
+        valoresS[ i ] = suma; \
+    } \
+}
+
+
+#define NUCLEO_SIMPLE( NOMBRE, ATRIBUTOS, TIPO ) \
+ATRIBUTOS static void NOMBRE( const struct Medida *medida, \
+    double *valoresS ) \
+{ \
+    const double *valoresA = medida->valoresA; \
+    const TIPO *e = medida->e; \
+    long R = medida->R; \
+    \
+    double suma; \
+    long i; \
+    \
+    \
+    /* Una única suma en lugar de NUM_S */ \
+    for( i = 0, suma = 0; i < R; i++ ) \
+    { \
+        suma += valoresA[ e[ i ] ]; \
+    } \
+    \
+    valoresS[ 0 ] = suma; \
+}
+
+
+#define NUCLEO_DIRECTO( NOMBRE, ATRIBUTOS ) \
+ATRIBUTOS static void NOMBRE( const struct Medida *medida, \
+    double *valoresS ) \
+{ \
+    const double *valoresA = medida->valoresA; \
+    long R = medida->R; \
+    long D = medida->D; \
+    \
+    double suma; \
+    long j; \
+    int i; \
+    \
+    \
+    for( i = 0; i < NUM_S; i++ ) \
+    { \
+        /* Se prescinde del array e, calculando directamente el índice */ \
+        for( j = 0, suma = 0; j < R; j++ ) \
+        { \
+            suma += valoresA[ j * D ]; \
+        } \
+        \
+        valoresS[ i ] = suma; \
+    } \
+}
+
+
+#define NUCLEO_DOBLE( NOMBRE, ATRIBUTOS ) \
+ATRIBUTOS static void NOMBRE( const struct Medida *medida, \
+    double *valoresS ) \
+{ \
+    const double *valoresA = medida->valoresA; \
+    long R = medida->R; \
+    long D = medida->D; \
+    \
+    double suma; \
+    long i; \
+    \
+    \
+    /* Acceso directo y una única suma */ \
+    for( i = 0, suma = 0; i < R; i++ ) \
+    { \
+        suma += valoresA[ i * D ]; \
+    } \
+    \
+    valoresS[ 0 ] = suma; \
+}
+
+
+VERSIONES( NUCLEO_JUNTO, nucleoJunto32, int )
+VERSIONES( NUCLEO_JUNTO, nucleoJunto64, long )
+VERSIONES( NUCLEO_SEPARADO, nucleoSeparado32, int )
+VERSIONES( NUCLEO_SEPARADO, nucleoSeparado64, long )
+VERSIONES( NUCLEO_SIMPLE, nucleoSimple32, int )
+VERSIONES( NUCLEO_SIMPLE, nucleoSimple64, long )
+VERSIONES( NUCLEO_DIRECTO, nucleoDirecto )
+VERSIONES( NUCLEO_DOBLE, nucleoDoble )
+
+
+static void nucleoJunto( const struct Medida *medida, double *valoresS )
+{
+    if( medida->anchoIndices == 64 )
+    {
+        nucleoJunto64Versiones[ medida->version ]( medida, valoresS );
+    }
+    else
+    {
+        nucleoJunto32Versiones[ medida->version ]( medida, valoresS );
+    }
+}
+
+
+static void nucleoSeparado( const struct Medida *medida, double *valoresS )
+{
+    if( medida->anchoIndices == 64 )
+    {
+        nucleoSeparado64Versiones[ medida->version ]( medida, valoresS );
+    }
+    else
+    {
+        nucleoSeparado32Versiones[ medida->version ]( medida, valoresS );
+    }
+}
+
+
+static void nucleoDirecto( const struct Medida *medida, double *valoresS )
+{
+    nucleoDirectoVersiones[ medida->version ]( medida, valoresS );
+}
+
+
+static void nucleoSimple( const struct Medida *medida, double *valoresS )
+{
+    if( medida->anchoIndices == 64 )
+    {
+        nucleoSimple64Versiones[ medida->version ]( medida, valoresS );
+    }
+    else
+    {
+        nucleoSimple32Versiones[ medida->version ]( medida, valoresS );
+    }
+}
+
+
+static void nucleoDoble( const struct Medida *medida, double *valoresS )
+{
+    nucleoDobleVersiones[ medida->version ]( medida, valoresS );
+}
+
+
+/* Tabla de modos; el bucle de precarga es el mismo que el de junto, sólo
+   cambia la forma de generar los índices */
+const struct Modo modos[ NUM_MODOS ] =
+{
+    [ MODO_JUNTO ] = { .nombre = "junto", .numSumas = NUM_S,
+        .indices = 1, .versiones = 1, .nucleo = nucleoJunto },
+    [ MODO_SEPARADO ] = { .nombre = "separado", .numSumas = NUM_S,
+        .indices = 1, .versiones = 1, .nucleo = nucleoSeparado },
+    [ MODO_DIRECTO ] = { .nombre = "directo", .numSumas = NUM_S,
+        .versiones = 1, .nucleo = nucleoDirecto },
+    [ MODO_SIMPLE ] = { .nombre = "simple", .numSumas = 1,
+        .indices = 1, .versiones = 1, .nucleo = nucleoSimple },
+    [ MODO_DOBLE ] = { .nombre = "doble", .numSumas = 1,
+        .versiones = 1, .nucleo = nucleoDoble },
+    [ MODO_PRECARGA ] = { .nombre = "precarga", .numSumas = NUM_S,
+        .entorno = 1, .indices = 1, .nucleo = nucleoJunto },
+    [ MODO_LATENCIA ] = { .nombre = "latencia", .numSumas = NUM_S,
+        .cadena = 1, .nucleo = nucleoLatencia },
+    [ MODO_GATHER256 ] = { .nombre = "gather256", .numSumas = NUM_S,
+        .indices = 1, .nucleo = nucleoGather256,
+        .disponible = disponibleAVX2 },
+    [ MODO_GATHER512 ] = { .nombre = "gather512", .numSumas = NUM_S,
+        .indices = 1, .nucleo = nucleoGather512,
+        .disponible = disponibleAVX512 },
+    [ MODO_PREF_DIRECTO ] = { .nombre = "prefdirecto", .numSumas = NUM_S,
+        .precarga = 1, .nucleo = nucleoPrecargaDirecto },
+    [ MODO_PREF_JUNTO ] = { .nombre = "prefjunto", .numSumas = NUM_S,
+        .precarga = 1, .indices = 1, .nucleo = nucleoPrecargaJunto },
+    [ MODO_HILOS ] = { .nombre = "hilos", .numSumas = NUM_S,
+        .hilos = 1, .nucleo = nucleoDirecto },
+    [ MODO_ESCRITURA ] = { .nombre = "escritura", .numSumas = NUM_S,
+        .escritura = 1, .nucleo = nucleoEscritura },
+    [ MODO_ACTUALIZACION ] = { .nombre = "actualizacion", .numSumas = NUM_S,
+        .escritura = 1, .nucleo = nucleoActualizacion },
+    [ MODO_FLUJO ] = { .nombre = "flujo", .numSumas = NUM_S,
+        .escritura = 1, .nucleo = nucleoFlujo },
+    [ MODO_ASOCIATIVIDAD ] = { .nombre = "asociatividad", .numSumas = NUM_S,
+        .asociatividad = 1, .nucleo = nucleoLatencia },
+    [ MODO_PATRON ] = { .nombre = "patron", .numSumas = NUM_S,
+        .indices = 1, .patron = 1, .nucleo = nucleoJunto },
+    [ MODO_MLP ] = { .nombre = "mlp", .numSumas = NUM_S, .cadena = 1,
+        .mlp = 1, .nucleo = nucleoMlp },
+    [ MODO_ACUMULADORES ] = { .nombre = "acumuladores", .numSumas = NUM_S,
+        .acumuladores = 1, .nucleo = nucleoAcumuladores },
+    [ MODO_COMPRIMIDO ] = { .nombre = "comprimido", .numSumas = NUM_S,
+        .comprimido = 1, .nucleo = nucleoComprimido,
+        .disponible = disponibleAVX2 },
+    [ MODO_ESPECIALIZADO ] = { .nombre = "especializado", .numSumas = NUM_S,
+        .especializado = 1, .nucleo = nucleoEspecializado },
+    [ MODO_CARGA ] = { .nombre = "carga", .numSumas = NUM_S, .cadena = 1,
+        .carga = 1, .nucleo = nucleoLatencia }
+};
+
+
+const int anchosIndices[ NUM_ANCHOS ] = { 32, 64 };
+
+
+int buscarModo( const char *nombre )
+{
+    // Contador
+    int i;
+
+
+    for( i = 0; i < NUM_MODOS; i++ )
+    {
+        if( strcmp( modos[ i ].nombre, nombre ) == 0 )
+        {
+            return( i );
+        }
+    }
+
+    return( -1 );
+}
+
+
+int modoDisponible( int modo )
+{
+    return( modos[ modo ].disponible == NULL || modos[ modo ].disponible() );
+}
+
+
+int buscarAncho( const char *nombre )
+{
+    // Contador
+    int i;
+
+
+    for( i = 0; i < NUM_ANCHOS; i++ )
+    {
+        if( atoi( nombre ) == anchosIndices[ i ] )
+        {
+            return( anchosIndices[ i ] );
+        }
+    }
+
+    return( -1 );
+}
+
+
+void generarIndices( void *e, long R, long D, int entorno,
+    int anchoIndices )
+{
+    // Vector e visto con cada anchura
+    int *e32 = e;
+    long *e64 = e;
+
+    // Índice calculado
+    long indice;
+
+    // Contador
+    long i;
+
+
+    for( i = 0; i < R; i++ )
+    {
+        // Se consideran el número de posición y el paso dado, junto a un
+        // entero aleatorio entre [0, ENTORNO) si así se indica
+        indice = i * D + ( entorno ? rand() % ENTORNO : 0 );
+
+        if( anchoIndices == 64 )
+        {
+            e64[ i ] = indice;
+        }
+        else
+        {
+            e32[ i ] = ( int )indice;
+        }
+    }
+}
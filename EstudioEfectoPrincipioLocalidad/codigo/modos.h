@@ -0,0 +1,186 @@
+#ifndef MODOS_H
+#define MODOS_H
+
+
+/* Macros varias */
+#define NUM_S 10
+#define ENTORNO 3
+
+// Anchuras admitidas de los índices de e[], en bits
+#define NUM_ANCHOS 2
+
+// Máximo de cadenas independientes del modo mlp
+#define MAX_CADENAS 32
+
+// Máximo de acumuladores independientes del modo acumuladores
+#define MAX_ACUMULADORES 16
+
+// Máximo desenrollado de los núcleos del modo especializado
+#define MAX_DESENROLLADO 8
+
+
+/* Modos de acceso disponibles; cada uno corresponde a uno de los programas
+   de pruebas originales */
+enum ModoAcceso
+{
+    MODO_JUNTO,         // junto.c: valoresA[ e[ j ] ], NUM_S sumas
+    MODO_SEPARADO,      // separado.c: índice obtenido aparte, NUM_S sumas
+    MODO_DIRECTO,       // directo.c: valoresA[ j * D ], NUM_S sumas
+    MODO_SIMPLE,        // simple.c: valoresA[ e[ i ] ], una suma
+    MODO_DOBLE,         // doble.c: valoresA[ i * D ], una suma
+    MODO_PRECARGA,      // precargaHardware.c: e[] con desplazamiento
+                        // aleatorio en [0, ENTORNO), NUM_S sumas
+    MODO_LATENCIA,      // Recorrido de una cadena de punteros de L nodos
+    MODO_GATHER256,     // junto.c con gathers AVX2 de 4 elementos
+    MODO_GATHER512,     // junto.c con gathers AVX-512 de 8 elementos
+    MODO_PREF_DIRECTO,  // directo.c con _mm_prefetch explícito
+    MODO_PREF_JUNTO,    // junto.c con _mm_prefetch explícito
+    MODO_HILOS,         // directo.c en varios hilos fijados a cores
+    MODO_ESCRITURA,     // directo.c escribiendo valoresA[ j * D ]
+    MODO_ACTUALIZACION, // directo.c con valoresA[ j * D ] += k
+    MODO_FLUJO,         // directo.c con escrituras no temporales
+    MODO_ASOCIATIVIDAD, // Cadena de K líneas en el mismo conjunto de caché
+    MODO_PATRON,        // junto.c con e[] ordenado según cada patrón
+    MODO_MLP,           // De 1 a N cadenas de punteros recorridas a la vez
+    MODO_ACUMULADORES,  // directo.c con K acumuladores o suma en árbol
+    MODO_COMPRIMIDO,    // junto.c con e[] comprimido y decodificado con AVX2
+    MODO_ESPECIALIZADO, // directo.c con D y desenrollado fijos al compilar
+    MODO_CARGA,         // Cadena de latencia con tráfico en otros cores
+    NUM_MODOS
+};
+
+
+/* Datos sobre los que trabaja el bucle computacional de una medida */
+struct Medida
+{
+    // Vector A y vector de índices e, de enteros de 32 bits (int) o de 64
+    // bits (long) según anchoIndices
+    double *valoresA;
+    void *e;
+    int anchoIndices;
+
+    // Cadena de punteros, con un nodo por línea caché
+    void **nodos;
+
+    // Cadenas independientes del modo mlp, y nodo en el que empieza cada una
+    int numCadenas;
+    void **inicios[ MAX_CADENAS ];
+
+    // Acumuladores independientes del modo acumuladores (0 para la
+    // reducción en árbol)
+    int numAcumuladores;
+
+    // Flujo de índices comprimido del modo comprimido (struct
+    // IndicesComprimidos)
+    const void *comprimidos;
+
+    // Desenrollado del modo especializado, y si se usa el núcleo genérico
+    // aunque D tenga uno propio
+    int desenrollado;
+    int generico;
+
+    // Versión del bucle de los programas originales (enum Version)
+    int version;
+
+    // Número de accesos por suma y paso entre ellos; con 64 bits, R * D
+    // puede superar 2^31 en los conjuntos de varios gigabytes
+    long R;
+    long D;
+
+    // Precarga por software: iteraciones de adelanto (0 para no precargar)
+    // y pista de _mm_prefetch (índice en nombresPistas)
+    int distancia;
+    int pista;
+};
+
+
+/* Descripción de un modo de acceso */
+struct Modo
+{
+    // Nombre con el que se selecciona desde la línea de órdenes
+    const char *nombre;
+
+    // Número de reducciones que realiza el núcleo (NUM_S o 1); los ciclos se
+    // dividen entre numSumas * R, los accesos realmente realizados
+    int numSumas;
+
+    // Si los índices de e[] se desplazan aleatoriamente dentro de ENTORNO
+    int entorno;
+
+    // Si el núcleo lee el vector de índices e[], y por tanto se mide con
+    // cada anchura de índices pedida
+    int indices;
+
+    // Si el modo recorre la cadena de punteros en lugar del vector A; en tal
+    // caso R es el número de nodos de la cadena (uno por cada línea de L)
+    int cadena;
+
+    // Si el modo se mide para cada pista y distancia de precarga pedidas
+    int precarga;
+
+    // Si el modo se mide con 1 a N hilos, con vector A privado y compartido
+    int hilos;
+
+    // Si el núcleo escribe en el vector A, en cuyo caso trabaja sobre una
+    // copia para no alterar los datos del resto de modos
+    int escritura;
+
+    // Si el modo recorre, para cada nivel de caché, de 1 a 2 × asociatividad
+    // líneas que caen en el mismo conjunto; se mide una única vez, sin
+    // depender de D ni de L
+    int asociatividad;
+
+    // Si los índices de e[] se generan con cada patrón de acceso pedido
+    int patron;
+
+    // Si la cadena se reparte en 1 a N cadenas independientes recorridas a
+    // la vez
+    int mlp;
+
+    // Si el modo se mide con cada número de acumuladores pedido
+    int acumuladores;
+
+    // Si el modo lee e[] comprimido con cada codificación pedida
+    int comprimido;
+
+    // Si el modo se mide con cada desenrollado pedido, con D fijo al
+    // compilar y variable
+    int especializado;
+
+    // Si el bucle se ha compilado en varias versiones, y se mide con cada
+    // una de las pedidas
+    int versiones;
+
+    // Si la cadena se recorre mientras otros cores generan tráfico de
+    // fondo con cada número de hilos e intensidad pedidos
+    int carga;
+
+    // Bucle computacional; almacena cada reducción en valoresS
+    void ( *nucleo )( const struct Medida *medida, double *valoresS );
+
+    // Comprueba si la CPU admite el bucle; NULL si no requiere nada
+    int ( *disponible )( void );
+};
+
+
+extern const struct Modo modos[ NUM_MODOS ];
+extern const int anchosIndices[ NUM_ANCHOS ];
+
+
+/* Obliga al compilador a considerar usado un valor, sin generar ninguna
+   instrucción, para que no pueda descartar los accesos que lo producen */
+static inline void consumir( double valor )
+{
+    __asm__ volatile( "" : : "x"( valor ) );
+}
+
+
+/* Prototipos de las funciones a emplear */
+int buscarModo( const char *nombre );
+int modoDisponible( int modo );
+int buscarAncho( const char *nombre );
+void generarIndices( void *e, long R, long D, int entorno,
+    int anchoIndices );
+
+
+#endif
@@ -0,0 +1,280 @@
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <sched.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+#include <linux/mempolicy.h>
+
+#include "numa.h"
+
+
+/*
+Colocación de la memoria en nodos NUMA mediante las llamadas al sistema
+mbind y set_mempolicy, sin depender de libnuma. Con un único nodo todas las
+políticas equivalen a la local; la remota lo advierte al prepararse.
+*/
+
+
+/* Macros varias */
+#define MAX_NODOS ( 8 * sizeof( unsigned long ) )
+#define MUESTRAS_PAGINAS 1024
+
+
+const char *nombresColocaciones[ NUM_COLOCACIONES ] =
+{
+    [ COLOCACION_NINGUNA ] = "ninguna",
+    [ COLOCACION_LOCAL ] = "local",
+    [ COLOCACION_REMOTA ] = "remota",
+    [ COLOCACION_ENTRELAZADA ] = "entrelazada",
+    [ COLOCACION_PRIMER_CONTACTO ] = "primer_contacto"
+};
+
+
+// Nodos en línea, nodo del core que mide y nodo remoto elegido
+static unsigned long nodosEnLinea = 1;
+static int nodoLocal = 0;
+static int nodoRemoto = 0;
+
+
+int buscarColocacion( const char *nombre )
+{
+    // Contador
+    int i;
+
+
+    for( i = 0; i < NUM_COLOCACIONES; i++ )
+    {
+        if( strcmp( nombresColocaciones[ i ], nombre ) == 0 )
+        {
+            return( i );
+        }
+    }
+
+    return( -1 );
+}
+
+
+/* Lee la lista de nodos en línea, con el formato "0-1,3" de sysfs */
+static unsigned long leerNodosEnLinea( void )
+{
+    unsigned long mascara;
+    int inicio;
+    int fin;
+    char separador;
+    FILE *f;
+
+
+    if( ( f = fopen( "/sys/devices/system/node/online", "r" ) ) == NULL )
+    {
+        return( 1 );
+    }
+
+    for( mascara = 0; fscanf( f, "%d", &inicio ) == 1; )
+    {
+        fin = inicio;
+        separador = ( char )fgetc( f );
+
+        if( separador == '-' )
+        {
+            if( fscanf( f, "%d", &fin ) != 1 )
+            {
+                break;
+            }
+
+            separador = ( char )fgetc( f );
+        }
+
+        for( ; inicio <= fin && inicio < ( int )MAX_NODOS; inicio++ )
+        {
+            mascara |= 1UL << inicio;
+        }
+
+        if( separador != ',' )
+        {
+            break;
+        }
+    }
+
+    fclose( f );
+
+    return( mascara != 0 ? mascara : 1 );
+}
+
+
+void prepararNuma( void )
+{
+    cpu_set_t afinidad;
+    unsigned cpu;
+    unsigned nodo;
+    int i;
+
+
+    nodosEnLinea = leerNodosEnLinea();
+
+    // Se fija el hilo que mide al core en el que se encuentra, de modo que
+    // "local" y "remoto" no cambien durante la ejecución
+    if( syscall( SYS_getcpu, &cpu, &nodo, NULL ) != 0 )
+    {
+        cpu = 0;
+        nodo = 0;
+    }
+
+    CPU_ZERO( &afinidad );
+    CPU_SET( cpu, &afinidad );
+    sched_setaffinity( 0, sizeof( cpu_set_t ), &afinidad );
+
+    nodoLocal = nodo;
+
+    // El nodo remoto es el primero en línea distinto del local
+    for( i = 0, nodoRemoto = nodoLocal; i < ( int )MAX_NODOS; i++ )
+    {
+        if( i != nodoLocal && ( nodosEnLinea & ( 1UL << i ) ) )
+        {
+            nodoRemoto = i;
+            break;
+        }
+    }
+
+    if( nodoRemoto == nodoLocal )
+    {
+        fprintf( stderr, "Sólo hay un nodo NUMA; la colocación remota "
+            "equivale a la local\n" );
+    }
+}
+
+
+void fijarPoliticaHilo( int colocacion )
+{
+    // Las páginas del hilo que mide se colocan en su nodo al escribirlas por
+    // primera vez; el resto de políticas recuperan la política por defecto.
+    // MPOL_LOCAL coincide con ella, pero se fija explícitamente para que
+    // primer_contacto sea el control de local: mismo nodo sin mbind ni
+    // migración, de modo que una diferencia entre ambas se debe a mbind
+    if( syscall( SYS_set_mempolicy, colocacion == COLOCACION_PRIMER_CONTACTO ?
+        MPOL_LOCAL : MPOL_DEFAULT, NULL, 0 ) != 0 )
+    {
+        perror( "set_mempolicy" );
+    }
+}
+
+
+void colocarBloque( void *bloque, size_t bytes, int colocacion )
+{
+    unsigned long mascara;
+    uintptr_t inicio;
+    uintptr_t fin;
+    long tamPagina;
+    int politica;
+
+
+    switch( colocacion )
+    {
+        case COLOCACION_LOCAL:
+            politica = MPOL_BIND;
+            mascara = 1UL << nodoLocal;
+            break;
+
+        case COLOCACION_REMOTA:
+            politica = MPOL_BIND;
+            mascara = 1UL << nodoRemoto;
+            break;
+
+        case COLOCACION_ENTRELAZADA:
+            politica = MPOL_INTERLEAVE;
+            mascara = nodosEnLinea;
+            break;
+
+        default:
+            return;
+    }
+
+    // mbind trabaja con páginas completas, de modo que el bloque debe venir
+    // de mmap (ver reserva en struct Arena) para no alcanzar datos vecinos
+    tamPagina = sysconf( _SC_PAGESIZE );
+    inicio = ( uintptr_t )bloque & ~( uintptr_t )( tamPagina - 1 );
+    fin = ( ( uintptr_t )bloque + bytes + tamPagina - 1 ) &
+        ~( uintptr_t )( tamPagina - 1 );
+
+    if( syscall( SYS_mbind, inicio, fin - inicio, politica, &mascara,
+        MAX_NODOS + 1, MPOL_MF_MOVE ) != 0 )
+    {
+        perror( "mbind" );
+    }
+}
+
+
+void comprobarColocacion( const void *bloque, size_t bytes,
+    const char *descripcion, FILE *salida )
+{
+    // Páginas muestreadas y nodo en el que se encuentra cada una
+    void *paginas[ MUESTRAS_PAGINAS ];
+    int estados[ MUESTRAS_PAGINAS ];
+
+    // Número de páginas en cada nodo
+    int porNodo[ MAX_NODOS ];
+    int errores;
+
+    size_t numPaginas;
+    size_t paso;
+    long tamPagina;
+    int numMuestras;
+    int i;
+
+
+    tamPagina = sysconf( _SC_PAGESIZE );
+    numPaginas = ( bytes + tamPagina - 1 ) / tamPagina;
+
+    // Se toman hasta MUESTRAS_PAGINAS páginas repartidas por todo el bloque
+    paso = numPaginas > MUESTRAS_PAGINAS ? numPaginas / MUESTRAS_PAGINAS : 1;
+
+    for( numMuestras = 0; numMuestras < MUESTRAS_PAGINAS &&
+        numMuestras * paso < numPaginas; numMuestras++ )
+    {
+        paginas[ numMuestras ] = ( char * )bloque + numMuestras * paso *
+            tamPagina;
+    }
+
+    // Sin nodos de destino, move_pages sólo informa de dónde está cada una
+    if( syscall( SYS_move_pages, 0, numMuestras, paginas, NULL, estados, 0 )
+        != 0 )
+    {
+        perror( "move_pages" );
+        return;
+    }
+
+    memset( porNodo, 0, sizeof( porNodo ) );
+
+    for( i = 0, errores = 0; i < numMuestras; i++ )
+    {
+        if( estados[ i ] >= 0 && estados[ i ] < ( int )MAX_NODOS )
+        {
+            porNodo[ estados[ i ] ]++;
+        }
+        else
+        {
+            errores++;
+        }
+    }
+
+    fprintf( salida, "%s:", descripcion );
+
+    for( i = 0; i < ( int )MAX_NODOS; i++ )
+    {
+        if( porNodo[ i ] > 0 )
+        {
+            fprintf( salida, " nodo %d %1.1lf%%", i, 100.0 * porNodo[ i ] /
+                numMuestras );
+        }
+    }
+
+    if( errores > 0 )
+    {
+        fprintf( salida, " sin colocar %1.1lf%%", 100.0 * errores /
+            numMuestras );
+    }
+
+    fprintf( salida, " (local %d, remoto %d)\n", nodoLocal, nodoRemoto );
+}
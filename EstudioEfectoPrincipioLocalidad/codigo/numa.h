@@ -0,0 +1,36 @@
+#ifndef NUMA_H
+#define NUMA_H
+
+#include <stdio.h>
+#include <stddef.h>
+
+
+/* Políticas de colocación de la memoria en los nodos NUMA */
+enum Colocacion
+{
+    COLOCACION_NINGUNA,         // La que resulte del primer contacto, sin
+                                // fijar el hilo que mide
+    COLOCACION_LOCAL,           // mbind al nodo del core que mide
+    COLOCACION_REMOTA,          // mbind a otro nodo distinto
+    COLOCACION_ENTRELAZADA,     // mbind entrelazando todos los nodos
+    COLOCACION_PRIMER_CONTACTO, // set_mempolicy( MPOL_LOCAL ) en el hilo que
+                                // mide, que es quien escribe los datos; es
+                                // la política por defecto del núcleo, y sirve
+                                // de control de local sin mbind
+    NUM_COLOCACIONES
+};
+
+
+extern const char *nombresColocaciones[ NUM_COLOCACIONES ];
+
+
+/* Prototipos de las funciones a emplear */
+int buscarColocacion( const char *nombre );
+void prepararNuma( void );
+void fijarPoliticaHilo( int colocacion );
+void colocarBloque( void *bloque, size_t bytes, int colocacion );
+void comprobarColocacion( const void *bloque, size_t bytes,
+    const char *descripcion, FILE *salida );
+
+
+#endif
@@ -0,0 +1,332 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "patrones.h"
+
+
+/*
+Generador de patrones de acceso para el modo patron, que recorre
+valoresA[ e[ j ] ] con el núcleo de junto. Cada patrón ordena las R
+posiciones 0, D, 2D..., de modo que todos leen los mismos datos con la misma
+huella en caché y sólo cambia el orden: la diferencia con adelante
+(que cualquier precargador de flujos cubre) y con aleatorio (que ninguno
+puede predecir) indica qué patrones cubren los precargadores hardware.
+*/
+
+
+const char *nombresPatrones[ NUM_PATRONES ] =
+{
+    [ PATRON_ADELANTE ] = "adelante",
+    [ PATRON_ATRAS ] = "atras",
+    [ PATRON_FLUJOS ] = "flujos",
+    [ PATRON_PAGINA ] = "pagina",
+    [ PATRON_PARES ] = "pares",
+    [ PATRON_CAMBIO ] = "cambio",
+    [ PATRON_ALEATORIO ] = "aleatorio"
+};
+
+// Parámetro de cada patrón si no se indica: flujos entrelazados, bytes de
+// cada región, posiciones de cada grupo y paso del segundo tramo
+static const long parametrosDefecto[ NUM_PATRONES ] =
+{
+    [ PATRON_FLUJOS ] = 4,
+    [ PATRON_PAGINA ] = 4096,
+    [ PATRON_PARES ] = 2,
+    [ PATRON_CAMBIO ] = 4
+};
+
+
+int leerPatrones( char *texto, struct Patron *patrones, int maxPatrones )
+{
+    // Número de patrones leídos
+    int numPatrones;
+
+    char *nombre;
+    char *parametro;
+
+    int i;
+
+
+    // Cada elemento de la lista es un nombre, seguido opcionalmente de ":" y
+    // el parámetro
+    for( numPatrones = 0, nombre = strtok( texto, "," );
+        nombre != NULL && numPatrones < maxPatrones;
+        nombre = strtok( NULL, "," ), numPatrones++ )
+    {
+        if( ( parametro = strchr( nombre, ':' ) ) != NULL )
+        {
+            *parametro++ = '\0';
+        }
+
+        for( i = 0; i < NUM_PATRONES &&
+            strcmp( nombresPatrones[ i ], nombre ) != 0; i++ );
+
+        if( i == NUM_PATRONES )
+        {
+            printf( "Patrón desconocido: %s\n", nombre );
+            exit( EXIT_FAILURE );
+        }
+
+        patrones[ numPatrones ].tipo = i;
+        patrones[ numPatrones ].parametro = parametro != NULL ?
+            atol( parametro ) : parametrosDefecto[ i ];
+
+        if( parametrosDefecto[ i ] > 0 && patrones[ numPatrones ].parametro
+            < 1 )
+        {
+            printf( "Parámetro incorrecto del patrón %s\n", nombre );
+            exit( EXIT_FAILURE );
+        }
+    }
+
+    return( numPatrones );
+}
+
+
+int todosPatrones( struct Patron *patrones )
+{
+    // Contador
+    int i;
+
+
+    for( i = 0; i < NUM_PATRONES; i++ )
+    {
+        patrones[ i ].tipo = i;
+        patrones[ i ].parametro = parametrosDefecto[ i ];
+    }
+
+    return( NUM_PATRONES );
+}
+
+
+void describirPatron( const struct Patron *patron, char *texto, int tam )
+{
+    if( parametrosDefecto[ patron->tipo ] > 0 )
+    {
+        snprintf( texto, tam, "%s:%ld", nombresPatrones[ patron->tipo ],
+            patron->parametro );
+    }
+    else
+    {
+        snprintf( texto, tam, "%s", nombresPatrones[ patron->tipo ] );
+    }
+}
+
+
+/* Desordena las posiciones [ inicio, fin ) de la permutación */
+static void barajar( long *posiciones, long inicio, long fin )
+{
+    long aux;
+    long i;
+    long j;
+
+
+    // Fisher-Yates; se combinan dos llamadas a rand() para alcanzar más de
+    // RAND_MAX posiciones
+    for( i = fin - 1; i > inicio; i-- )
+    {
+        j = inicio + ( ( ( long )rand() << 31 ) ^ rand() ) % ( i - inicio +
+            1 );
+        aux = posiciones[ i ];
+        posiciones[ i ] = posiciones[ j ];
+        posiciones[ j ] = aux;
+    }
+}
+
+
+/* Calcula en qué orden se recorren las R posiciones */
+static void ordenarPosiciones( long *posiciones, long R, long D,
+    const struct Patron *patron )
+{
+    // Posiciones por flujo, región o grupo, y de cada tramo
+    long tam;
+    long tramo;
+
+    // Grupos en orden aleatorio
+    long *grupos;
+    long numGrupos;
+
+    // Posiciones de la mitad recorrida con paso N, en su orden, y primera
+    // de ellas
+    long *columnas;
+    long mitad;
+
+    long posicion;
+    long i;
+    long j;
+    long k;
+
+
+    switch( patron->tipo )
+    {
+        case PATRON_ADELANTE:
+            for( i = 0; i < R; i++ )
+            {
+                posiciones[ i ] = i;
+            }
+            break;
+
+        case PATRON_ATRAS:
+            for( i = 0; i < R; i++ )
+            {
+                posiciones[ i ] = R - 1 - i;
+            }
+            break;
+
+        case PATRON_FLUJOS:
+            // Se divide el recorrido en tramos contiguos y se avanza uno de
+            // cada vez
+            tam = ( R + patron->parametro - 1 ) / patron->parametro;
+
+            for( k = 0, i = 0; k < tam; k++ )
+            {
+                for( j = 0; j < patron->parametro; j++ )
+                {
+                    if( j * tam + k < R )
+                    {
+                        posiciones[ i++ ] = j * tam + k;
+                    }
+                }
+            }
+            break;
+
+        case PATRON_PAGINA:
+            tam = patron->parametro / ( D * ( long )sizeof( double ) );
+            tam = tam > 1 ? tam : 1;
+
+            for( i = 0; i < R; i++ )
+            {
+                posiciones[ i ] = i;
+            }
+
+            for( i = 0; i < R; i += tam )
+            {
+                barajar( posiciones, i, i + tam < R ? i + tam : R );
+            }
+            break;
+
+        case PATRON_PARES:
+            tam = patron->parametro;
+            numGrupos = ( R + tam - 1 ) / tam;
+
+            if( ( grupos = malloc( numGrupos * sizeof( long ) ) ) == NULL )
+            {
+                perror( "Reserva de memoria fallida" );
+                exit( EXIT_FAILURE );
+            }
+
+            for( k = 0; k < numGrupos; k++ )
+            {
+                grupos[ k ] = k;
+            }
+
+            barajar( grupos, 0, numGrupos );
+
+            for( k = 0, i = 0; k < numGrupos; k++ )
+            {
+                for( j = grupos[ k ] * tam; j < ( grupos[ k ] + 1 ) * tam &&
+                    j < R; j++ )
+                {
+                    posiciones[ i++ ] = j;
+                }
+            }
+
+            free( grupos );
+            break;
+
+        case PATRON_CAMBIO:
+            // Los tramos de paso 1 recorren la primera mitad y los de paso N
+            // la segunda, dividida en bloques de N × TRAMO_CAMBIO posiciones
+            // que se recorren columna a columna; así cada posición se visita
+            // una sola vez, como en el resto de patrones
+            mitad = R / 2;
+            tam = patron->parametro * TRAMO_CAMBIO;
+
+            if( ( columnas = malloc( ( R - mitad ) * sizeof( long ) ) ) ==
+                NULL )
+            {
+                perror( "Reserva de memoria fallida" );
+                exit( EXIT_FAILURE );
+            }
+
+            for( k = mitad, j = 0; k < R; k += tam )
+            {
+                for( posicion = k; posicion < k + patron->parametro;
+                    posicion++ )
+                {
+                    for( i = posicion; i < k + tam && i < R;
+                        i += patron->parametro )
+                    {
+                        columnas[ j++ ] = i;
+                    }
+                }
+            }
+
+            // Se alternan tramos de cada mitad; agotada una, se sigue con
+            // la otra
+            for( i = 0, j = 0, k = 0; i < R; i++ )
+            {
+                tramo = ( i / TRAMO_CAMBIO ) % 2;
+
+                if( ( tramo == 0 && j < mitad ) || k == R - mitad )
+                {
+                    posiciones[ i ] = j++;
+                }
+                else
+                {
+                    posiciones[ i ] = columnas[ k++ ];
+                }
+            }
+
+            free( columnas );
+            break;
+
+        case PATRON_ALEATORIO:
+            for( i = 0; i < R; i++ )
+            {
+                posiciones[ i ] = i;
+            }
+
+            barajar( posiciones, 0, R );
+            break;
+    }
+}
+
+
+void generarPatron( void *e, long R, long D, const struct Patron *patron,
+    int anchoIndices )
+{
+    // Vector e visto con cada anchura
+    int *e32 = e;
+    long *e64 = e;
+
+    // Orden de las posiciones
+    long *posiciones;
+
+    // Contador
+    long i;
+
+
+    if( ( posiciones = malloc( R * sizeof( long ) ) ) == NULL )
+    {
+        perror( "Reserva de memoria fallida" );
+        exit( EXIT_FAILURE );
+    }
+
+    ordenarPosiciones( posiciones, R, D, patron );
+
+    for( i = 0; i < R; i++ )
+    {
+        if( anchoIndices == 64 )
+        {
+            e64[ i ] = posiciones[ i ] * D;
+        }
+        else
+        {
+            e32[ i ] = ( int )( posiciones[ i ] * D );
+        }
+    }
+
+    free( posiciones );
+}
@@ -0,0 +1,53 @@
+#ifndef PATRONES_H
+#define PATRONES_H
+
+
+/* Macros varias */
+#define MAX_PATRONES 32
+
+// Número de accesos de cada tramo del patrón de cambio de paso
+#define TRAMO_CAMBIO 256
+
+// Fracción del beneficio de adelante sobre aleatorio a partir de la cual se
+// considera que los precargadores cubren un patrón
+#define UMBRAL_COBERTURA 0.75
+
+
+/* Patrones de acceso que recorre el modo patron; todos visitan las mismas R
+   posiciones ( índices múltiplos de D ) en distinto orden */
+enum TipoPatron
+{
+    PATRON_ADELANTE,    // 0, 1, 2... (referencia cubierta)
+    PATRON_ATRAS,       // R - 1, R - 2...
+    PATRON_FLUJOS,      // N flujos hacia delante entrelazados
+    PATRON_PAGINA,      // Aleatorio dentro de cada región de N bytes,
+                        // recorriendo las regiones hacia delante
+    PATRON_PARES,       // Grupos de N posiciones consecutivas en orden
+                        // aleatorio
+    PATRON_CAMBIO,      // Paso 1 y paso N alternados cada TRAMO_CAMBIO
+                        // accesos, en mitades distintas del recorrido
+    PATRON_ALEATORIO,   // Permutación aleatoria (referencia no cubierta)
+    NUM_PATRONES
+};
+
+
+/* Patrón a medir y su parámetro (0 en los que no tienen) */
+struct Patron
+{
+    int tipo;
+    long parametro;
+};
+
+
+extern const char *nombresPatrones[ NUM_PATRONES ];
+
+
+/* Prototipos de las funciones a emplear */
+int leerPatrones( char *texto, struct Patron *patrones, int maxPatrones );
+int todosPatrones( struct Patron *patrones );
+void describirPatron( const struct Patron *patron, char *texto, int tam );
+void generarPatron( void *e, long R, long D, const struct Patron *patron,
+    int anchoIndices );
+
+
+#endif
@@ -0,0 +1,181 @@
+#include <string.h>
+#include <xmmintrin.h>
+
+#include "precarga.h"
+
+
+/*
+Precarga por software explícita: en cada iteración se pide con _mm_prefetch
+el elemento que se accederá medida->distancia iteraciones después. La pista
+debe ser una constante para la instrucción, por lo que cada bucle se
+instancia una vez por pista mediante una macro. Las últimas iteraciones se
+realizan sin precarga, para no pedir posiciones fuera de e[]. Con distancia
+0 no se precarga nada, lo que proporciona la referencia de cada bucle. El
+bucle sobre e[] se instancia además para índices de 32 y de 64 bits.
+*/
+
+
+const char *nombresPistas[ NUM_PISTAS ] = { "t0", "t1", "t2", "nta" };
+
+
+#define BUCLE_PRECARGA_DIRECTO( PISTA ) \
+    for( i = 0; i < NUM_S; i++ ) \
+    { \
+        for( j = 0, suma = 0; j < R - distancia; j++ ) \
+        { \
+            _mm_prefetch( ( const char * )&valoresA[ ( j + distancia ) * D ], \
+                PISTA ); \
+            suma += valoresA[ j * D ]; \
+        } \
+        \
+        for( ; j < R; j++ ) \
+        { \
+            suma += valoresA[ j * D ]; \
+        } \
+        \
+        valoresS[ i ] = suma; \
+    }
+
+
+#define BUCLE_PRECARGA_JUNTO( PISTA ) \
+    for( i = 0; i < NUM_S; i++ ) \
+    { \
+        for( j = 0, suma = 0; j < R - distancia; j++ ) \
+        { \
+            _mm_prefetch( ( const char * )&valoresA[ e[ j + distancia ] ], \
+                PISTA ); \
+            suma += valoresA[ e[ j ] ]; \
+        } \
+        \
+        for( ; j < R; j++ ) \
+        { \
+            suma += valoresA[ e[ j ] ]; \
+        } \
+        \
+        valoresS[ i ] = suma; \
+    }
+
+
+int buscarPista( const char *nombre )
+{
+    // Contador
+    int i;
+
+
+    for( i = 0; i < NUM_PISTAS; i++ )
+    {
+        if( strcmp( nombresPistas[ i ], nombre ) == 0 )
+        {
+            return( i );
+        }
+    }
+
+    return( -1 );
+}
+
+
+void nucleoPrecargaDirecto( const struct Medida *medida, double *valoresS )
+{
+    const double *valoresA = medida->valoresA;
+    long R = medida->R;
+    long D = medida->D;
+    long distancia = medida->distancia;
+
+    double suma;
+    long j;
+    int i;
+
+
+    switch( distancia > 0 ? medida->pista : -1 )
+    {
+        case 0:
+            BUCLE_PRECARGA_DIRECTO( _MM_HINT_T0 );
+            break;
+
+        case 1:
+            BUCLE_PRECARGA_DIRECTO( _MM_HINT_T1 );
+            break;
+
+        case 2:
+            BUCLE_PRECARGA_DIRECTO( _MM_HINT_T2 );
+            break;
+
+        case 3:
+            BUCLE_PRECARGA_DIRECTO( _MM_HINT_NTA );
+            break;
+
+        default:
+            // Referencia sin precarga
+            for( i = 0; i < NUM_S; i++ )
+            {
+                for( j = 0, suma = 0; j < R; j++ )
+                {
+                    suma += valoresA[ j * D ];
+                }
+
+                valoresS[ i ] = suma;
+            }
+    }
+}
+
+
+#define NUCLEO_PRECARGA_JUNTO( NOMBRE, TIPO ) \
+static void NOMBRE( const struct Medida *medida, double *valoresS ) \
+{ \
+    const double *valoresA = medida->valoresA; \
+    const TIPO *e = medida->e; \
+    long R = medida->R; \
+    long distancia = medida->distancia; \
+    \
+    double suma; \
+    long j; \
+    int i; \
+    \
+    \
+    switch( distancia > 0 ? medida->pista : -1 ) \
+    { \
+        case 0: \
+            BUCLE_PRECARGA_JUNTO( _MM_HINT_T0 ); \
+            break; \
+        \
+        case 1: \
+            BUCLE_PRECARGA_JUNTO( _MM_HINT_T1 ); \
+            break; \
+        \
+        case 2: \
+            BUCLE_PRECARGA_JUNTO( _MM_HINT_T2 ); \
+            break; \
+        \
+        case 3: \
+            BUCLE_PRECARGA_JUNTO( _MM_HINT_NTA ); \
+            break; \
+        \
+        default: \
+            for( i = 0; i < NUM_S; i++ ) \
+            { \
+                for( j = 0, suma = 0; j < R; j++ ) \
+                { \
+                    suma += valoresA[ e[ j ] ]; \
+                } \
+                \
+                valoresS[ i ] = suma; \
+            } \
+    } \
+}
+
+
+NUCLEO_PRECARGA_JUNTO( nucleoPrecargaJunto32, int )
+NUCLEO_PRECARGA_JUNTO( nucleoPrecargaJunto64, long )
+
+
+void nucleoPrecargaJunto( const struct Medida *medida, double *valoresS )
+{
+    if( medida->anchoIndices == 64 )
+    {
+        nucleoPrecargaJunto64( medida, valoresS );
+    }
+    else
+    {
+        nucleoPrecargaJunto32( medida, valoresS );
+    }
+}
@@ -0,0 +1,22 @@
+#ifndef PRECARGA_H
+#define PRECARGA_H
+
+#include "modos.h"
+
+
+/* Macros varias */
+#define NUM_PISTAS 4
+#define MAX_DISTANCIAS 32
+
+
+/* Nombres de las pistas de _mm_prefetch, en el orden de medida.pista */
+extern const char *nombresPistas[ NUM_PISTAS ];
+
+
+/* Prototipos de las funciones a emplear */
+int buscarPista( const char *nombre );
+void nucleoPrecargaDirecto( const struct Medida *medida, double *valoresS );
+void nucleoPrecargaJunto( const struct Medida *medida, double *valoresS );
+
+
+#endif
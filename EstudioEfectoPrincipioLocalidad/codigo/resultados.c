@@ -0,0 +1,1079 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "asociatividad.h"
+#include "memoria.h"
+#include "mlp.h"
+#include "modos.h"
+#include "numa.h"
+#include "patrones.h"
+#include "precarga.h"
+#include "resultados.h"
+#include "salida.h"
+
+
+const char *nombresEstados[ NUM_ESTADOS ] =
+{
+    [ ESTADO_CALIENTE ] = "caliente",
+    [ ESTADO_FRIO ] = "frio"
+};
+
+
+int buscarEstado( const char *nombre )
+{
+    // Contador
+    int i;
+
+
+    for( i = 0; i < NUM_ESTADOS; i++ )
+    {
+        if( strcmp( nombresEstados[ i ], nombre ) == 0 )
+        {
+            return( i );
+        }
+    }
+
+    return( -1 );
+}
+
+
+void inicializarResultados( struct ListaResultados *lista )
+{
+    lista->resultados = NULL;
+    lista->numResultados = 0;
+    lista->capacidad = 0;
+}
+
+
+struct Resultado *anadirResultado( struct ListaResultados *lista )
+{
+    struct Resultado *resultado;
+
+    // Contador
+    int i;
+
+
+    // Se duplica la capacidad cuando se agota
+    if( lista->numResultados == lista->capacidad )
+    {
+        lista->capacidad = lista->capacidad == 0 ? 64 : 2 * lista->capacidad;
+
+        if( ( lista->resultados = realloc( lista->resultados,
+            lista->capacidad * sizeof( struct Resultado ) ) ) == NULL )
+        {
+            perror( "Reserva de memoria fallida" );
+            exit( EXIT_FAILURE );
+        }
+    }
+
+    resultado = &lista->resultados[ lista->numResultados++ ];
+
+    memset( resultado, 0, sizeof( struct Resultado ) );
+    strcpy( resultado->variante, "-" );
+
+    for( i = 0; i < NUM_EVENTOS; i++ )
+    {
+        resultado->eventos[ i ] = -1;
+    }
+
+    return( resultado );
+}
+
+
+/* Anchura de los índices para los resúmenes ("" si el modo no lee e[]) */
+static const char *describirAncho( int anchoIndices )
+{
+    return( anchoIndices == 64 ? " índices de 64 bits" :
+        anchoIndices == 32 ? " índices de 32 bits" : "" );
+}
+
+
+/* Escribe una medida como una línea csv */
+static void escribirCsv( const struct Resultado *r, FILE *fichero )
+{
+    // Contador
+    int j;
+
+
+    // Se imprimen el valor de L, el número de ciclos por acceso, el valor de
+    // D (0 en el modo de latencia), el modo, los nanosegundos por acceso, la
+    // variante del modo, la forma de reservar memoria (seguida de la
+    // colocación NUMA, si se ha fijado), los estadísticos de las
+    // repeticiones, el estado de las cachés, la anchura de los índices y los
+    // eventos hardware por acceso en un formato csv que vaya a interpretar
+    // el graficador
+    fprintf( fichero, "%d,%1.10lf,%d,%s,%1.4lf,%s,%s%s%s,"
+        "%1.10lf,%1.10lf,%1.10lf,%1.10lf,%d,%d,%s,%d", r->L,
+        r->ciclos, r->D, modos[ r->modo ].nombre, r->ns, r->variante,
+        nombresMemorias[ r->memoria ],
+        r->colocacion != COLOCACION_NINGUNA ? "/" : "",
+        r->colocacion != COLOCACION_NINGUNA ?
+        nombresColocaciones[ r->colocacion ] : "",
+        r->estadisticas.minimo, r->estadisticas.p90, r->estadisticas.p99,
+        r->estadisticas.desviacion, r->estadisticas.numMuestras,
+        r->estadisticas.numAtipicas, nombresEstados[ r->estado ],
+        r->anchoIndices );
+
+    // Los eventos no contados quedan como "-"
+    for( j = 0; j < NUM_EVENTOS; j++ )
+    {
+        if( r->eventos[ j ] < 0 )
+        {
+            fprintf( fichero, ",-" );
+        }
+        else
+        {
+            fprintf( fichero, ",%1.6lf", r->eventos[ j ] );
+        }
+    }
+
+    fprintf( fichero, "\n" );
+}
+
+
+/* Escribe una medida como un objeto JSON en una línea */
+static void escribirJson( const struct Resultado *r, FILE *fichero )
+{
+    // Campos reales de la medida
+    const char *nombres[] = { "ciclos", "ns", "minimo", "p90", "p99",
+        "media", "desviacion" };
+    double valores[] = { r->ciclos, r->ns, r->estadisticas.minimo,
+        r->estadisticas.p90, r->estadisticas.p99, r->estadisticas.media,
+        r->estadisticas.desviacion };
+
+    // Contador
+    int j;
+
+
+    fprintf( fichero, "{\"tipo\":\"medida\",\"modo\":\"%s\",\"L\":%d,"
+        "\"D\":%d,\"variante\":", modos[ r->modo ].nombre, r->L, r->D );
+    escribirCadena( fichero, r->variante );
+    fprintf( fichero, ",\"memoria\":\"%s\",\"colocacion\":\"%s\","
+        "\"estado\":\"%s\",\"anchoIndices\":%d",
+        nombresMemorias[ r->memoria ], nombresColocaciones[ r->colocacion ],
+        nombresEstados[ r->estado ], r->anchoIndices );
+
+    // Los valores no finitos se escriben como null
+    for( j = 0; j < ( int )( sizeof( valores ) / sizeof( valores[ 0 ] ) );
+        j++ )
+    {
+        fprintf( fichero, ",\"%s\":", nombres[ j ] );
+        escribirReal( fichero, "%1.6lf", valores[ j ] );
+    }
+
+    fprintf( fichero, ",\"muestras\":%d,\"atipicas\":%d,\"suma\":",
+        r->estadisticas.numMuestras, r->estadisticas.numAtipicas );
+    escribirReal( fichero, "%1.17g", r->suma );
+
+    // Sólo los eventos contados
+    for( j = 0; j < NUM_EVENTOS; j++ )
+    {
+        if( r->eventos[ j ] >= 0 )
+        {
+            fprintf( fichero, ",\"%s\":", nombresEventos[ j ] );
+            escribirReal( fichero, "%1.6lf", r->eventos[ j ] );
+        }
+    }
+
+    if( r->bytesIndices > 0 )
+    {
+        fprintf( fichero, ",\"bytesIndices\":" );
+        escribirReal( fichero, "%1.4lf", r->bytesIndices );
+    }
+
+    if( r->anchoBanda > 0 )
+    {
+        fprintf( fichero, ",\"anchoBanda\":" );
+        escribirReal( fichero, "%1.4lf", r->anchoBanda );
+    }
+
+    fprintf( fichero, "}\n" );
+}
+
+
+void escribirResultados( const struct ListaResultados *lista, int formato,
+    FILE *fichero )
+{
+    // Contador
+    int i;
+
+
+    for( i = 0; i < lista->numResultados; i++ )
+    {
+        if( formato == FORMATO_CSV )
+        {
+            escribirCsv( &lista->resultados[ i ], fichero );
+        }
+        else
+        {
+            escribirJson( &lista->resultados[ i ], fichero );
+        }
+    }
+}
+
+
+void resumirPrecarga( const struct ListaResultados *lista, FILE *salida )
+{
+    // Medida sin precarga del grupo iterado y mejor medida con precarga
+    const struct Resultado *base;
+    const struct Resultado *mejor;
+
+    const struct Resultado *r;
+    int pista;
+    int i;
+    int j;
+
+
+    for( i = 0; i < lista->numResultados; i++ )
+    {
+        base = &lista->resultados[ i ];
+
+        // Los grupos comienzan por la medida con distancia 0, seguida de las
+        // de cada pista y distancia
+        if( !modos[ base->modo ].precarga || base->distancia != 0 )
+        {
+            continue;
+        }
+
+        for( pista = 0; pista < NUM_PISTAS; pista++ )
+        {
+            mejor = NULL;
+
+            for( j = i + 1; j < lista->numResultados; j++ )
+            {
+                r = &lista->resultados[ j ];
+
+                if( r->modo != base->modo || r->distancia == 0 )
+                {
+                    break;
+                }
+
+                if( r->pista == pista && ( mejor == NULL ||
+                    r->ciclos < mejor->ciclos ) )
+                {
+                    mejor = r;
+                }
+            }
+
+            if( mejor != NULL )
+            {
+                fprintf( salida, "%s D=%d L=%d %s %s: mejor distancia %d, "
+                    "%1.4lf -> %1.4lf ciclos por acceso (x%1.3lf)\n",
+                    modos[ base->modo ].nombre, base->D, base->L,
+                    nombresEstados[ base->estado ], nombresPistas[ pista ],
+                    mejor->distancia, base->ciclos,
+                    mejor->ciclos, base->ciclos / mejor->ciclos );
+            }
+        }
+    }
+}
+
+
+void resumirMemorias( const struct ListaResultados *lista, FILE *salida )
+{
+    // Medida con páginas de 4 KiB y la equivalente con otra reserva
+    const struct Resultado *base;
+    const struct Resultado *r;
+
+    int i;
+    int j;
+
+
+    for( i = 0; i < lista->numResultados; i++ )
+    {
+        base = &lista->resultados[ i ];
+
+        if( base->memoria != MEMORIA_MM_MALLOC )
+        {
+            continue;
+        }
+
+        // Se busca el mismo punto medido con páginas enormes; como los datos
+        // y el recorrido son idénticos, la diferencia se debe a la TLB
+        for( j = i + 1; j < lista->numResultados; j++ )
+        {
+            r = &lista->resultados[ j ];
+
+            if( r->memoria != MEMORIA_MM_MALLOC && r->modo == base->modo &&
+                r->colocacion == base->colocacion &&
+                r->estado == base->estado && r->L == base->L &&
+                r->D == base->D && r->anchoIndices == base->anchoIndices &&
+                strcmp( r->variante, base->variante ) == 0 )
+            {
+                fprintf( salida, "%s D=%d L=%d %s %s%s: %s %1.4lf ciclos "
+                    "por acceso, %s %1.4lf (coste TLB %1.4lf)\n",
+                    modos[ base->modo ].nombre, base->D, base->L,
+                    base->variante, nombresEstados[ base->estado ],
+                    describirAncho( base->anchoIndices ),
+                    nombresMemorias[ base->memoria ],
+                    base->ciclos, nombresMemorias[ r->memoria ], r->ciclos,
+                    base->ciclos - r->ciclos );
+            }
+        }
+    }
+}
+
+
+void resumirAsociatividad( const struct ListaResultados *lista,
+    const struct GeometriaCache *geometria, FILE *salida )
+{
+    // Ciclos por acceso de cada K del nivel iterado
+    double ciclos[ MAX_K ];
+    int numK;
+
+    // Primer resultado del nivel, y asociatividad medida en el anterior
+    const struct Resultado *base;
+    int anterior;
+
+    int codo;
+    int nivel;
+    int i;
+    int n;
+
+
+    for( i = 0, anterior = 0; i < lista->numResultados; )
+    {
+        base = &lista->resultados[ i ];
+
+        if( base->modo != MODO_ASOCIATIVIDAD || base->L != 1 )
+        {
+            i++;
+            continue;
+        }
+
+        // Se recogen las medidas consecutivas del mismo nivel, ordenadas
+        // por K
+        for( numK = 0; i < lista->numResultados && numK < MAX_K &&
+            lista->resultados[ i ].modo == MODO_ASOCIATIVIDAD &&
+            lista->resultados[ i ].L == numK + 1 &&
+            strcmp( lista->resultados[ i ].variante, base->variante ) == 0;
+            i++ )
+        {
+            ciclos[ numK++ ] = lista->resultados[ i ].ciclos;
+        }
+
+        // El primer nivel sirve los accesos desde K = 1; los siguientes, a
+        // partir de que se supera la asociatividad del anterior
+        nivel = atoi( base->variante + 1 );
+        anterior = nivel == geometria->niveles[ 0 ].nivel ? 0 : anterior;
+        codo = buscarCodo( ciclos, numK, anterior + 1 );
+
+        for( n = 0; n < geometria->numNiveles &&
+            geometria->niveles[ n ].nivel != nivel; n++ );
+
+        if( codo > 0 )
+        {
+            fprintf( salida, "Asociatividad %s (%s): codo en K = %d (%1.2lf "
+                "-> %1.2lf ciclos por acceso), %d vías medidas, %d "
+                "nominales\n", base->variante,
+                nombresMemorias[ base->memoria ], codo, ciclos[ codo - 2 ],
+                ciclos[ codo - 1 ], codo - 1, n < geometria->numNiveles ?
+                geometria->niveles[ n ].vias : 0 );
+            anterior = codo - 1;
+        }
+        else
+        {
+            fprintf( salida, "Asociatividad %s (%s): no se observa codo "
+                "hasta K = %d\n", base->variante,
+                nombresMemorias[ base->memoria ], numK );
+        }
+    }
+}
+
+
+void resumirEventos( const struct ListaResultados *lista,
+    const struct GeometriaCache *geometria, FILE *salida )
+{
+    // Suma de los eventos por acceso y número de medidas contadas de cada
+    // modo, nivel en el que cabe la huella (numNiveles para la memoria) y
+    // estado de las cachés
+    static double sumas[ NUM_MODOS ][ MAX_NIVELES_CACHE + 1 ][ NUM_ESTADOS ]
+        [ NUM_EVENTOS ];
+    static int contadas[ NUM_MODOS ][ MAX_NIVELES_CACHE + 1 ][ NUM_ESTADOS ];
+
+    const struct Resultado *r;
+
+    int nivel;
+    int m;
+    int f;
+    int i;
+    int j;
+
+
+    memset( sumas, 0, sizeof( sumas ) );
+    memset( contadas, 0, sizeof( contadas ) );
+
+    // Los eventos de cada medida ya están en el fichero de resultados; aquí
+    // sólo se agregan, para no imprimir una línea por medida
+    for( i = 0; i < lista->numResultados; i++ )
+    {
+        r = &lista->resultados[ i ];
+
+        for( j = 0; j < NUM_EVENTOS && r->eventos[ j ] < 0; j++ );
+
+        // Solo las medidas en las que se ha contado algún evento
+        if( j == NUM_EVENTOS )
+        {
+            continue;
+        }
+
+        for( nivel = 0; nivel < geometria->numNiveles &&
+            ( long )r->L * geometria->tamLinea >
+            geometria->niveles[ nivel ].tam; nivel++ );
+
+        contadas[ r->modo ][ nivel ][ r->estado ]++;
+
+        for( j = 0; j < NUM_EVENTOS; j++ )
+        {
+            sumas[ r->modo ][ nivel ][ r->estado ][ j ] += r->eventos[ j ];
+        }
+    }
+
+    for( m = 0; m < NUM_MODOS; m++ )
+    {
+        for( nivel = 0; nivel <= geometria->numNiveles; nivel++ )
+        {
+            for( f = 0; f < NUM_ESTADOS; f++ )
+            {
+                if( contadas[ m ][ nivel ][ f ] == 0 )
+                {
+                    continue;
+                }
+
+                if( nivel < geometria->numNiveles )
+                {
+                    fprintf( salida, "%s L%d %s (%d medidas):",
+                        modos[ m ].nombre, geometria->niveles[ nivel ].nivel,
+                        nombresEstados[ f ], contadas[ m ][ nivel ][ f ] );
+                }
+                else
+                {
+                    fprintf( salida, "%s memoria %s (%d medidas):",
+                        modos[ m ].nombre, nombresEstados[ f ],
+                        contadas[ m ][ nivel ][ f ] );
+                }
+
+                // Los eventos no contados suman -1 por medida
+                for( j = 0; j < NUM_EVENTOS; j++ )
+                {
+                    if( sumas[ m ][ nivel ][ f ][ j ] >= 0 )
+                    {
+                        fprintf( salida, " %s %1.4lf", nombresEventos[ j ],
+                            sumas[ m ][ nivel ][ f ][ j ] /
+                            contadas[ m ][ nivel ][ f ] );
+                    }
+                }
+
+                fprintf( salida, " por acceso de media\n" );
+            }
+        }
+    }
+}
+
+
+/* Indica si dos medidas corresponden al mismo punto, salvo el modo y la
+   variante */
+static int mismoPunto( const struct Resultado *a, const struct Resultado *b )
+{
+    return( a->L == b->L && a->D == b->D && a->memoria == b->memoria &&
+        a->colocacion == b->colocacion && a->estado == b->estado &&
+        a->anchoIndices == b->anchoIndices );
+}
+
+
+void resumirAcumuladores( const struct ListaResultados *lista,
+    FILE *salida )
+{
+    // Medida con un único acumulador, la de cada variante y la mejor
+    const struct Resultado *base;
+    const struct Resultado *mejor;
+    const struct Resultado *r;
+
+    int i;
+    int j;
+
+
+    for( i = 0; i < lista->numResultados; i++ )
+    {
+        base = &lista->resultados[ i ];
+
+        if( base->modo != MODO_ACUMULADORES ||
+            strcmp( base->variante, "1" ) != 0 )
+        {
+            continue;
+        }
+
+        fprintf( salida, "acumuladores D=%d L=%d %s: 1 acumulador %1.4lf "
+            "ciclos por acceso;", base->D, base->L,
+            nombresEstados[ base->estado ], base->ciclos );
+
+        for( j = 0, mejor = base; j < lista->numResultados; j++ )
+        {
+            r = &lista->resultados[ j ];
+
+            if( r->modo != MODO_ACUMULADORES || r == base ||
+                !mismoPunto( r, base ) )
+            {
+                continue;
+            }
+
+            fprintf( salida, " %s %1.4lf", r->variante, r->ciclos );
+            mejor = r->ciclos < mejor->ciclos ? r : mejor;
+        }
+
+        fprintf( salida, "\n    mejor %s (x%1.2lf)\n", mejor->variante,
+            base->ciclos / mejor->ciclos );
+    }
+}
+
+
+void resumirComprimidos( const struct ListaResultados *lista, FILE *salida )
+{
+    // Medida con los índices sin comprimir y la de cada codificación
+    const struct Resultado *base;
+    const struct Resultado *r;
+
+    // Longitud del nombre de la fuente de índices, que precede a "/" en la
+    // variante
+    size_t fuente;
+
+    int i;
+    int j;
+
+
+    for( i = 0; i < lista->numResultados; i++ )
+    {
+        base = &lista->resultados[ i ];
+
+        if( base->modo != MODO_COMPRIMIDO ||
+            strchr( base->variante, '/' ) == NULL ||
+            strcmp( strchr( base->variante, '/' ), "/plano" ) != 0 )
+        {
+            continue;
+        }
+
+        fuente = strchr( base->variante, '/' ) - base->variante;
+
+        // Cada acceso lee 8 bytes de A más los de su índice
+        fprintf( salida, "comprimido D=%d L=%d %.*s %s: plano %1.2lf+8 bytes "
+            "por acceso, %1.4lf ciclos\n", base->D, base->L, ( int )fuente,
+            base->variante, nombresEstados[ base->estado ],
+            base->bytesIndices, base->ciclos );
+
+        // Todas las codificaciones suman los mismos elementos en el mismo
+        // orden, de modo que una suma distinta indica un fallo al decodificar
+        for( j = 0; j < lista->numResultados; j++ )
+        {
+            r = &lista->resultados[ j ];
+
+            if( r->modo != MODO_COMPRIMIDO || r == base ||
+                !mismoPunto( r, base ) ||
+                strncmp( r->variante, base->variante, fuente + 1 ) != 0 )
+            {
+                continue;
+            }
+
+            fprintf( salida, "    %s %1.2lf+8 bytes (%1.0lf %% del tráfico), "
+                "%1.4lf ciclos (x%1.2lf)%s\n", r->variante + fuente + 1,
+                r->bytesIndices,
+                100 * ( 8 + r->bytesIndices ) / ( 8 + base->bytesIndices ),
+                r->ciclos, base->ciclos / r->ciclos, r->suma != base->suma ?
+                "; ¡suma distinta de plano!" : "" );
+        }
+    }
+}
+
+
+void resumirEspecializados( const struct ListaResultados *lista,
+    FILE *salida )
+{
+    // Medida del núcleo genérico sin desenrollar, la de cada variante y la
+    // más rápida
+    const struct Resultado *base;
+    const struct Resultado *mejor;
+    const struct Resultado *r;
+
+    int i;
+    int j;
+
+
+    for( i = 0; i < lista->numResultados; i++ )
+    {
+        base = &lista->resultados[ i ];
+
+        if( base->modo != MODO_ESPECIALIZADO ||
+            strcmp( base->variante, "variable u1" ) != 0 )
+        {
+            continue;
+        }
+
+        for( j = 0, mejor = base; j < lista->numResultados; j++ )
+        {
+            r = &lista->resultados[ j ];
+
+            if( r->modo == MODO_ESPECIALIZADO && mismoPunto( r, base ) &&
+                r->ciclos < mejor->ciclos )
+            {
+                mejor = r;
+            }
+        }
+
+        // Lo que el mejor bucle ahorra es sobrecarga del bucle; el resto es
+        // el coste de la memoria y de la cadena de sumas
+        fprintf( salida, "especializado D=%d L=%d %s: variable u1 %1.4lf "
+            "ciclos por acceso, mejor %s %1.4lf; sobrecarga del bucle "
+            "%1.4lf (%1.0lf %%), memoria y suma %1.4lf\n", base->D, base->L,
+            nombresEstados[ base->estado ], base->ciclos, mejor->variante,
+            mejor->ciclos, base->ciclos - mejor->ciclos,
+            100 * ( base->ciclos - mejor->ciclos ) / base->ciclos,
+            mejor->ciclos );
+    }
+}
+
+
+void resumirVersiones( const struct ListaResultados *lista, FILE *salida )
+{
+    // Primera versión medida de un punto y cada una de las demás
+    const struct Resultado *base;
+    const struct Resultado *r;
+
+    int i;
+    int j;
+
+
+    for( i = 0; i < lista->numResultados; i++ )
+    {
+        base = &lista->resultados[ i ];
+
+        // Las medidas de los bucles originales con una versión son las que
+        // tienen variante
+        if( !modos[ base->modo ].versiones ||
+            strcmp( base->variante, "-" ) == 0 )
+        {
+            continue;
+        }
+
+        // Sólo se parte de la primera versión de cada punto
+        for( j = 0; j < i; j++ )
+        {
+            r = &lista->resultados[ j ];
+
+            if( r->modo == base->modo && mismoPunto( r, base ) &&
+                strcmp( r->variante, "-" ) != 0 )
+            {
+                break;
+            }
+        }
+
+        if( j < i )
+        {
+            continue;
+        }
+
+        fprintf( salida, "%s D=%d L=%d %s: %s %1.4lf ciclos por acceso",
+            modos[ base->modo ].nombre, base->D, base->L,
+            nombresEstados[ base->estado ], base->variante, base->ciclos );
+
+        for( j = i + 1; j < lista->numResultados; j++ )
+        {
+            r = &lista->resultados[ j ];
+
+            if( r->modo == base->modo && mismoPunto( r, base ) &&
+                strcmp( r->variante, "-" ) != 0 )
+            {
+                fprintf( salida, ", %s %1.4lf (x%1.2lf)", r->variante,
+                    r->ciclos, base->ciclos / r->ciclos );
+            }
+        }
+
+        fprintf( salida, "\n" );
+    }
+}
+
+
+void resumirCarga( const struct ListaResultados *lista,
+    const struct GeometriaCache *geometria, FILE *salida )
+{
+    // Medida sin carga de fondo y cada una con carga
+    const struct Resultado *base;
+    const struct Resultado *r;
+
+    // Nivel en el que cabe la cadena (numNiveles para la memoria)
+    int nivel;
+
+    int i;
+    int j;
+
+
+    for( i = 0; i < lista->numResultados; i++ )
+    {
+        base = &lista->resultados[ i ];
+
+        if( base->modo != MODO_CARGA || strcmp( base->variante, "0" ) != 0 )
+        {
+            continue;
+        }
+
+        for( nivel = 0; nivel < geometria->numNiveles &&
+            ( long )base->L * geometria->tamLinea >
+            geometria->niveles[ nivel ].tam; nivel++ );
+
+        if( nivel < geometria->numNiveles )
+        {
+            fprintf( salida, "carga L=%d (L%d) %s: sin carga %1.2lf ns por "
+                "acceso\n", base->L, geometria->niveles[ nivel ].nivel,
+                nombresEstados[ base->estado ], base->ns );
+        }
+        else
+        {
+            fprintf( salida, "carga L=%d (memoria) %s: sin carga %1.2lf ns "
+                "por acceso\n", base->L, nombresEstados[ base->estado ],
+                base->ns );
+        }
+
+        // Cada punto de la curva: generadores/intensidad, ancho de banda
+        // consumido por ellos y latencia
+        for( j = 0; j < lista->numResultados; j++ )
+        {
+            r = &lista->resultados[ j ];
+
+            if( r->modo != MODO_CARGA || r == base || !mismoPunto( r, base ) )
+            {
+                continue;
+            }
+
+            fprintf( salida, "    %s %%: %1.2lf GB/s de fondo, %1.2lf ns "
+                "(x%1.2lf)\n", r->variante, r->anchoBanda, r->ns,
+                r->ns / base->ns );
+        }
+    }
+}
+
+
+void resumirMlp( const struct ListaResultados *lista, FILE *salida )
+{
+    // Medida con una única cadena, y la de cada número de cadenas
+    const struct Resultado *base;
+    const struct Resultado *r;
+
+    // Aceleración de cada número de cadenas respecto a una
+    double aceleraciones[ MAX_CADENAS + 1 ];
+    double maxima;
+    int numCadenas;
+
+    int i;
+    int j;
+    int n;
+
+
+    for( i = 0; i < lista->numResultados; i++ )
+    {
+        base = &lista->resultados[ i ];
+
+        if( base->modo != MODO_MLP || strcmp( base->variante, "1" ) != 0 )
+        {
+            continue;
+        }
+
+        fprintf( salida, "mlp L=%d %s %s: 1 cadena %1.4lf ciclos por "
+            "acceso;", base->L, nombresMemorias[ base->memoria ],
+            nombresEstados[ base->estado ], base->ciclos );
+
+        for( n = 0; n <= MAX_CADENAS; n++ )
+        {
+            aceleraciones[ n ] = 0;
+        }
+
+        for( j = i + 1, maxima = 1, numCadenas = 1; j < lista->numResultados;
+            j++ )
+        {
+            r = &lista->resultados[ j ];
+            n = atoi( r->variante );
+
+            if( r->modo != MODO_MLP || !mismoPunto( r, base ) || n < 2 ||
+                n > MAX_CADENAS )
+            {
+                continue;
+            }
+
+            aceleraciones[ n ] = base->ciclos / r->ciclos;
+            maxima = aceleraciones[ n ] > maxima ? aceleraciones[ n ] :
+                maxima;
+            numCadenas = n > numCadenas ? n : numCadenas;
+
+            fprintf( salida, " %d x%1.2lf", n, aceleraciones[ n ] );
+        }
+
+        // Se toma como saturación el primer número de cadenas que alcanza
+        // casi la mayor aceleración
+        aceleraciones[ 1 ] = 1;
+
+        for( n = 1; n < numCadenas &&
+            aceleraciones[ n ] < UMBRAL_SATURACION * maxima; n++ );
+
+        fprintf( salida, "\n    aceleración máxima x%1.2lf, saturada con %d "
+            "cadenas\n", maxima, n );
+    }
+}
+
+
+void resumirPatrones( const struct ListaResultados *lista, FILE *salida )
+{
+    // Referencias cubierta (adelante) y no cubierta (aleatorio) del punto
+    const struct Resultado *adelante;
+    const struct Resultado *aleatorio;
+
+    const struct Resultado *r;
+
+    // Fracción del beneficio de adelante sobre aleatorio que conserva cada
+    // patrón
+    double cobertura;
+
+    int i;
+    int j;
+
+
+    for( i = 0; i < lista->numResultados; i++ )
+    {
+        adelante = &lista->resultados[ i ];
+
+        if( adelante->modo != MODO_PATRON ||
+            strcmp( adelante->variante, nombresPatrones[ PATRON_ADELANTE ] )
+            != 0 )
+        {
+            continue;
+        }
+
+        for( j = 0, aleatorio = NULL; j < lista->numResultados; j++ )
+        {
+            r = &lista->resultados[ j ];
+
+            if( r->modo == MODO_PATRON && mismoPunto( r, adelante ) &&
+                strcmp( r->variante,
+                nombresPatrones[ PATRON_ALEATORIO ] ) == 0 )
+            {
+                aleatorio = r;
+            }
+        }
+
+        // Si el orden no importa (el punto cabe en la L1, o no se han
+        // medido ambas referencias), no se puede hablar de cobertura
+        if( aleatorio == NULL || aleatorio->ciclos <= adelante->ciclos )
+        {
+            continue;
+        }
+
+        fprintf( salida, "patron D=%d L=%d %s: adelante %1.4lf ciclos por "
+            "acceso, aleatorio %1.4lf\n", adelante->D, adelante->L,
+            nombresEstados[ adelante->estado ], adelante->ciclos,
+            aleatorio->ciclos );
+
+        for( j = 0; j < lista->numResultados; j++ )
+        {
+            r = &lista->resultados[ j ];
+
+            if( r->modo != MODO_PATRON || !mismoPunto( r, adelante ) ||
+                r == adelante || r == aleatorio )
+            {
+                continue;
+            }
+
+            cobertura = ( aleatorio->ciclos - r->ciclos ) /
+                ( aleatorio->ciclos - adelante->ciclos );
+
+            fprintf( salida, "    %-16s %1.4lf ciclos por acceso, cobertura "
+                "%3.0lf %% (%s)\n", r->variante, r->ciclos, 100 * cobertura,
+                cobertura >= UMBRAL_COBERTURA ? "cubierto" : "no cubierto" );
+        }
+    }
+}
+
+
+void resumirIndices( const struct ListaResultados *lista, FILE *salida )
+{
+    // Medida con índices de 32 bits y la equivalente con índices de 64
+    const struct Resultado *base;
+    const struct Resultado *r;
+
+    int i;
+    int j;
+
+
+    for( i = 0; i < lista->numResultados; i++ )
+    {
+        base = &lista->resultados[ i ];
+
+        if( base->anchoIndices != 32 )
+        {
+            continue;
+        }
+
+        // Cada acceso lee además su índice, por lo que el ancho de banda del
+        // flujo de índices es su tamaño entre el tiempo por acceso
+        for( j = i + 1; j < lista->numResultados; j++ )
+        {
+            r = &lista->resultados[ j ];
+
+            if( r->anchoIndices == 64 && r->modo == base->modo &&
+                r->memoria == base->memoria &&
+                r->colocacion == base->colocacion &&
+                r->estado == base->estado && r->L == base->L &&
+                r->D == base->D &&
+                strcmp( r->variante, base->variante ) == 0 )
+            {
+                fprintf( salida, "%s D=%d L=%d %s %s %s%s%s: índices de "
+                    "32 bits %1.4lf ciclos por acceso (%1.3lf GB/s de "
+                    "índices), de 64 bits %1.4lf (%1.3lf GB/s; coste "
+                    "%1.4lf)\n", modos[ base->modo ].nombre, base->D,
+                    base->L, base->variante, nombresEstados[ base->estado ],
+                    nombresMemorias[ base->memoria ],
+                    base->colocacion != COLOCACION_NINGUNA ? "/" : "",
+                    base->colocacion != COLOCACION_NINGUNA ?
+                    nombresColocaciones[ base->colocacion ] : "",
+                    base->ciclos, 4 / base->ns, r->ciclos,
+                    8 / r->ns, r->ciclos - base->ciclos );
+            }
+        }
+    }
+}
+
+
+void resumirEstados( const struct ListaResultados *lista, FILE *salida )
+{
+    // Medida con las cachés calientes y la equivalente con ellas frías
+    const struct Resultado *base;
+    const struct Resultado *r;
+
+    int i;
+    int j;
+
+
+    for( i = 0; i < lista->numResultados; i++ )
+    {
+        base = &lista->resultados[ i ];
+
+        if( base->estado != ESTADO_CALIENTE )
+        {
+            continue;
+        }
+
+        for( j = i + 1; j < lista->numResultados; j++ )
+        {
+            r = &lista->resultados[ j ];
+
+            if( r->estado == ESTADO_FRIO && r->modo == base->modo &&
+                r->memoria == base->memoria &&
+                r->colocacion == base->colocacion && r->L == base->L &&
+                r->D == base->D && r->anchoIndices == base->anchoIndices &&
+                strcmp( r->variante, base->variante ) == 0 )
+            {
+                fprintf( salida, "%s D=%d L=%d %s %s%s%s%s: caliente "
+                    "%1.4lf ciclos por acceso, frio %1.4lf (coste caché fría "
+                    "%1.4lf)\n", modos[ base->modo ].nombre, base->D,
+                    base->L, base->variante, nombresMemorias[ base->memoria ],
+                    base->colocacion != COLOCACION_NINGUNA ? "/" : "",
+                    base->colocacion != COLOCACION_NINGUNA ?
+                    nombresColocaciones[ base->colocacion ] : "",
+                    describirAncho( base->anchoIndices ), base->ciclos,
+                    r->ciclos,
+                    r->ciclos - base->ciclos );
+            }
+        }
+    }
+}
+
+
+void resumirEscrituras( const struct ListaResultados *lista, FILE *salida )
+{
+    // Medida de lectura directa y la equivalente con escrituras
+    const struct Resultado *base;
+    const struct Resultado *r;
+
+    int i;
+    int j;
+
+
+    for( i = 0; i < lista->numResultados; i++ )
+    {
+        base = &lista->resultados[ i ];
+
+        if( base->modo != MODO_DIRECTO )
+        {
+            continue;
+        }
+
+        // El recorrido es el mismo, por lo que la diferencia con la lectura
+        // es el coste de traer la línea para escribirla y de expulsarla
+        // modificada en el nivel al que corresponde L
+        for( j = 0; j < lista->numResultados; j++ )
+        {
+            r = &lista->resultados[ j ];
+
+            if( ( r->modo == MODO_ESCRITURA || r->modo == MODO_ACTUALIZACION ||
+                r->modo == MODO_FLUJO ) && r->memoria == base->memoria &&
+                r->colocacion == base->colocacion &&
+                r->estado == base->estado && r->L == base->L &&
+                r->D == base->D )
+            {
+                fprintf( salida, "D=%d L=%d: lectura %1.4lf ciclos por "
+                    "acceso, %s %1.4lf (coste escritura %1.4lf)\n", base->D,
+                    base->L, base->ciclos, modos[ r->modo ].nombre,
+                    r->ciclos, r->ciclos - base->ciclos );
+            }
+        }
+    }
+}
+
+
+void resumirColocaciones( const struct ListaResultados *lista, FILE *salida )
+{
+    // Medida con la memoria en el nodo local y la equivalente con otra
+    // colocación
+    const struct Resultado *base;
+    const struct Resultado *r;
+
+    int i;
+    int j;
+
+
+    for( i = 0; i < lista->numResultados; i++ )
+    {
+        base = &lista->resultados[ i ];
+
+        if( base->colocacion != COLOCACION_LOCAL )
+        {
+            continue;
+        }
+
+        for( j = i + 1; j < lista->numResultados; j++ )
+        {
+            r = &lista->resultados[ j ];
+
+            if( r->colocacion != COLOCACION_LOCAL &&
+                r->colocacion != COLOCACION_NINGUNA &&
+                r->memoria == base->memoria && r->modo == base->modo &&
+                r->estado == base->estado && r->L == base->L &&
+                r->D == base->D && r->anchoIndices == base->anchoIndices &&
+                strcmp( r->variante, base->variante ) == 0 )
+            {
+                fprintf( salida, "%s D=%d L=%d %s %s %s%s: local %1.4lf "
+                    "ciclos por acceso, %s %1.4lf (penalización x%1.3lf)\n",
+                    modos[ base->modo ].nombre, base->D, base->L,
+                    base->variante, nombresMemorias[ base->memoria ],
+                    nombresEstados[ base->estado ],
+                    describirAncho( base->anchoIndices ), base->ciclos,
+                    nombresColocaciones[ r->colocacion ], r->ciclos,
+                    r->ciclos / base->ciclos );
+            }
+        }
+    }
+}
+
+
+void liberarResultados( struct ListaResultados *lista )
+{
+    free( lista->resultados );
+
+    inicializarResultados( lista );
+}
@@ -0,0 +1,113 @@
+#ifndef RESULTADOS_H
+#define RESULTADOS_H
+
+#include <stdio.h>
+
+#include "cache.h"
+#include "estadistica.h"
+#include "eventos.h"
+
+
+/* Macros varias */
+#define TAM_VARIANTE 64
+
+
+/* Estado de las cachés al comenzar cada repetición cronometrada */
+enum EstadoCache
+{
+    ESTADO_CALIENTE,    // Tras pasadas de calentamiento sin medir
+    ESTADO_FRIO,        // Tras expulsar de la caché los datos del núcleo
+    NUM_ESTADOS
+};
+
+
+/* Resultado de una medida, guardado hasta el final de la ejecución */
+struct Resultado
+{
+    int L;
+    int D;
+    int modo;
+
+    // Forma de reservar la memoria (enum TipoMemoria) y colocación en los
+    // nodos NUMA (enum Colocacion)
+    int memoria;
+    int colocacion;
+
+    // Estado de las cachés (enum EstadoCache)
+    int estado;
+
+    // Anchura en bits de los índices de e[] (0 si el modo no lo lee)
+    int anchoIndices;
+
+    // Parámetros propios del modo, y su descripción textual ("-" si no hay)
+    int distancia;
+    int pista;
+    char variante[ TAM_VARIANTE ];
+
+    // Ciclos por acceso (mediana de las repeticiones), y su equivalente en
+    // nanosegundos
+    double ciclos;
+    double ns;
+
+    // Estadísticos de las repeticiones cronometradas por separado
+    struct Estadisticas estadisticas;
+
+    // Cuentas de los contadores hardware por acceso, sumando todas las
+    // repeticiones (negativas si el evento no se ha contado)
+    double eventos[ NUM_EVENTOS ];
+
+    // Bytes del flujo de índices por acceso en el modo comprimido (0 en el
+    // resto)
+    double bytesIndices;
+
+    // Ancho de banda de la carga de fondo del modo carga, en GB/s (0 en el
+    // resto)
+    double anchoBanda;
+
+    // Suma de las reducciones obtenidas, que se guarda con el resultado
+    double suma;
+};
+
+
+/* Resultados de toda la ejecución; crece según se añaden medidas */
+struct ListaResultados
+{
+    struct Resultado *resultados;
+    int numResultados;
+    int capacidad;
+};
+
+
+extern const char *nombresEstados[ NUM_ESTADOS ];
+
+
+/* Prototipos de las funciones a emplear */
+int buscarEstado( const char *nombre );
+void inicializarResultados( struct ListaResultados *lista );
+struct Resultado *anadirResultado( struct ListaResultados *lista );
+void escribirResultados( const struct ListaResultados *lista, int formato,
+    FILE *fichero );
+void resumirPrecarga( const struct ListaResultados *lista, FILE *salida );
+void resumirMemorias( const struct ListaResultados *lista, FILE *salida );
+void resumirAsociatividad( const struct ListaResultados *lista,
+    const struct GeometriaCache *geometria, FILE *salida );
+void resumirEventos( const struct ListaResultados *lista,
+    const struct GeometriaCache *geometria, FILE *salida );
+void resumirAcumuladores( const struct ListaResultados *lista,
+    FILE *salida );
+void resumirComprimidos( const struct ListaResultados *lista, FILE *salida );
+void resumirEspecializados( const struct ListaResultados *lista,
+    FILE *salida );
+void resumirVersiones( const struct ListaResultados *lista, FILE *salida );
+void resumirCarga( const struct ListaResultados *lista,
+    const struct GeometriaCache *geometria, FILE *salida );
+void resumirMlp( const struct ListaResultados *lista, FILE *salida );
+void resumirPatrones( const struct ListaResultados *lista, FILE *salida );
+void resumirIndices( const struct ListaResultados *lista, FILE *salida );
+void resumirEstados( const struct ListaResultados *lista, FILE *salida );
+void resumirEscrituras( const struct ListaResultados *lista, FILE *salida );
+void resumirColocaciones( const struct ListaResultados *lista, FILE *salida );
+void liberarResultados( struct ListaResultados *lista );
+
+
+#endif
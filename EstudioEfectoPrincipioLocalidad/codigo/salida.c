@@ -0,0 +1,298 @@
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <cpuid.h>
+#include <sys/utsname.h>
+
+#include "salida.h"
+
+
+/*
+Escritura de los resultados. En formato JSON cada ejecución añade al fichero
+una línea de cabecera con el equipo, la CPU, el compilador, las opciones con
+las que se compiló, la línea de órdenes, los modos pedidos y la calibración
+del contador, seguida de una línea por medida, de modo que cada resultado
+se pueda atribuir al binario y la máquina que lo produjeron. El fichero se
+escribe a través de un búfer grande, y se vuelca una única vez al cerrarlo.
+*/
+
+
+/* Macros varias */
+#define TAM_BUFER_SALIDA ( 1 << 20 )
+
+// Opciones de compilación; se pueden indicar al compilar con
+// -DOPCIONES_COMPILACION="\"...\"", y si no se deducen de las macros
+// predefinidas
+#ifndef OPCIONES_COMPILACION
+#define OPCIONES_COMPILACION ""
+#endif
+
+// Nombre y versión del compilador; __VERSION__ no incluye el nombre en gcc
+#if defined( __INTEL_LLVM_COMPILER ) || defined( __INTEL_COMPILER )
+#define COMPILADOR "icc " __VERSION__
+#elif defined( __clang__ )
+#define COMPILADOR "clang " __VERSION__
+#else
+#define COMPILADOR "gcc " __VERSION__
+#endif
+
+
+const char *nombresFormatos[ NUM_FORMATOS ] =
+{
+    [ FORMATO_JSON ] = "json",
+    [ FORMATO_CSV ] = "csv"
+};
+
+static const char *ficherosFormatos[ NUM_FORMATOS ] =
+{
+    [ FORMATO_JSON ] = "resultado.jsonl",
+    [ FORMATO_CSV ] = "resultado.csv"
+};
+
+
+// Búfer del fichero de resultados
+static char *bufer = NULL;
+
+
+int buscarFormato( const char *nombre )
+{
+    // Contador
+    int i;
+
+
+    for( i = 0; i < NUM_FORMATOS; i++ )
+    {
+        if( strcmp( nombresFormatos[ i ], nombre ) == 0 )
+        {
+            return( i );
+        }
+    }
+
+    return( -1 );
+}
+
+
+FILE *abrirSalida( int formato )
+{
+    FILE *fichero;
+
+
+    if( ( fichero = fopen( ficherosFormatos[ formato ], "a" ) ) == NULL )
+    {
+        perror( "No se ha podido abrir el fichero para escritura" );
+        exit( EXIT_FAILURE );
+    }
+
+    if( ( bufer = malloc( TAM_BUFER_SALIDA ) ) == NULL )
+    {
+        perror( "Reserva de memoria fallida" );
+        exit( EXIT_FAILURE );
+    }
+
+    setvbuf( fichero, bufer, _IOFBF, TAM_BUFER_SALIDA );
+
+    return( fichero );
+}
+
+
+void escribirCadena( FILE *fichero, const char *cadena )
+{
+    fputc( '"', fichero );
+
+    // Se escapan las comillas, las barras y los caracteres de control
+    for( ; *cadena != '\0'; cadena++ )
+    {
+        if( *cadena == '"' || *cadena == '\\' )
+        {
+            fprintf( fichero, "\\%c", *cadena );
+        }
+        else if( ( unsigned char )*cadena < 0x20 )
+        {
+            fprintf( fichero, "\\u%04x", *cadena );
+        }
+        else
+        {
+            fputc( *cadena, fichero );
+        }
+    }
+
+    fputc( '"', fichero );
+}
+
+
+void escribirReal( FILE *fichero, const char *formato, double valor )
+{
+    // JSON no admite NaN ni infinitos
+    if( isfinite( valor ) )
+    {
+        fprintf( fichero, formato, valor );
+    }
+    else
+    {
+        fprintf( fichero, "null" );
+    }
+}
+
+
+/* Obtiene el nombre comercial de la CPU de las hojas 0x80000002 a
+   0x80000004 de CPUID */
+static void leerNombreCpu( char *nombre )
+{
+    unsigned registros[ 12 ];
+
+    // Contador
+    int i;
+
+
+    nombre[ 0 ] = '\0';
+
+    if( __get_cpuid_max( 0x80000000, NULL ) < 0x80000004 )
+    {
+        return;
+    }
+
+    for( i = 0; i < 3; i++ )
+    {
+        __cpuid( 0x80000002 + i, registros[ 4 * i ], registros[ 4 * i + 1 ],
+            registros[ 4 * i + 2 ], registros[ 4 * i + 3 ] );
+    }
+
+    memcpy( nombre, registros, sizeof( registros ) );
+    nombre[ sizeof( registros ) ] = '\0';
+}
+
+
+/* Opciones de compilación deducidas de las macros predefinidas */
+static void deducirOpciones( char *opciones, size_t tam )
+{
+    snprintf( opciones, tam, "%s%s%s%s%s%s%s%s", OPCIONES_COMPILACION,
+#ifdef __OPTIMIZE__
+        " __OPTIMIZE__",
+#else
+        " -O0",
+#endif
+#ifdef __OPTIMIZE_SIZE__
+        " __OPTIMIZE_SIZE__",
+#else
+        "",
+#endif
+#ifdef _OPENMP
+        " _OPENMP",
+#else
+        "",
+#endif
+#ifdef __SSE3__
+        " __SSE3__",
+#else
+        "",
+#endif
+#ifdef __AVX__
+        " __AVX__",
+#else
+        "",
+#endif
+#ifdef __AVX2__
+        " __AVX2__",
+#else
+        "",
+#endif
+#ifdef __AVX512F__
+        " __AVX512F__"
+#else
+        ""
+#endif
+        );
+}
+
+
+void escribirCabecera( FILE *fichero, int formato,
+    const struct Cabecera *cabecera )
+{
+    struct utsname sistema;
+
+    // Nombre de la CPU y opciones de compilación
+    char cpu[ 49 ];
+    char opciones[ 256 ];
+
+    const struct NivelCache *nivel;
+    int primero;
+
+    // Contador
+    int i;
+
+
+    // El formato csv no lleva cabecera, para no romper los graficadores
+    if( formato != FORMATO_JSON )
+    {
+        return;
+    }
+
+    uname( &sistema );
+    leerNombreCpu( cpu );
+    deducirOpciones( opciones, sizeof( opciones ) );
+
+    fprintf( fichero, "{\"tipo\":\"cabecera\",\"fecha\":%ld,\"equipo\":",
+        ( long )time( NULL ) );
+    escribirCadena( fichero, sistema.nodename );
+    fprintf( fichero, ",\"sistema\":" );
+    escribirCadena( fichero, sistema.release );
+    fprintf( fichero, ",\"arquitectura\":" );
+    escribirCadena( fichero, sistema.machine );
+    fprintf( fichero, ",\"cpu\":" );
+    escribirCadena( fichero, cpu );
+    fprintf( fichero, ",\"compilador\":" );
+    escribirCadena( fichero, COMPILADOR );
+    fprintf( fichero, ",\"opciones\":" );
+    escribirCadena( fichero, opciones[ 0 ] == ' ' ? opciones + 1 : opciones );
+
+    fprintf( fichero, ",\"ordenes\":[" );
+
+    for( i = 0; i < cabecera->argc; i++ )
+    {
+        fputs( i > 0 ? "," : "", fichero );
+        escribirCadena( fichero, cabecera->argv[ i ] );
+    }
+
+    fprintf( fichero, "],\"modos\":[" );
+
+    for( i = 0, primero = 1; i < NUM_MODOS; i++ )
+    {
+        if( cabecera->seleccion[ i ] )
+        {
+            fputs( primero ? "" : ",", fichero );
+            escribirCadena( fichero, modos[ i ].nombre );
+            primero = 0;
+        }
+    }
+
+    fprintf( fichero, "],\"caches\":[" );
+
+    for( i = 0; i < cabecera->geometria->numNiveles; i++ )
+    {
+        nivel = &cabecera->geometria->niveles[ i ];
+        fprintf( fichero, "%s{\"nivel\":%d,\"tam\":%ld,\"vias\":%d,"
+            "\"linea\":%d,\"conjuntos\":%d}", i > 0 ? "," : "", nivel->nivel,
+            nivel->tam, nivel->vias, nivel->tamLinea, nivel->conjuntos );
+    }
+
+    fprintf( fichero, "],\"contador\":{\"tipo\":" );
+    escribirCadena( fichero, cabecera->calibracion->contador );
+    fprintf( fichero, ",\"origen\":" );
+    escribirCadena( fichero, cabecera->calibracion->origen );
+    fprintf( fichero, ",\"mhz\":" );
+    escribirReal( fichero, "%1.3lf", cabecera->calibracion->frecuencia );
+    fprintf( fichero, ",\"sobrecarga\":" );
+    escribirReal( fichero, "%1.1lf", cabecera->calibracion->sobrecarga );
+    fprintf( fichero, "},\"semilla\":%u}\n", cabecera->semilla );
+}
+
+
+void cerrarSalida( FILE *fichero )
+{
+    fclose( fichero );
+
+    free( bufer );
+    bufer = NULL;
+}
@@ -0,0 +1,50 @@
+#ifndef SALIDA_H
+#define SALIDA_H
+
+#include <stdio.h>
+
+#include "cache.h"
+#include "contador.h"
+#include "modos.h"
+
+
+/* Formatos en los que se guardan los resultados */
+enum FormatoSalida
+{
+    FORMATO_JSON,   // resultado.jsonl: una cabecera y un objeto por medida
+    FORMATO_CSV,    // resultado.csv: una línea por medida, sin cabecera
+    NUM_FORMATOS
+};
+
+
+/* Descripción de la ejecución, escrita antes de sus resultados */
+struct Cabecera
+{
+    // Línea de órdenes, copiada antes de que la lectura de las listas la
+    // modifique
+    int argc;
+    char **argv;
+
+    // Modos pedidos (1 en la posición de cada uno)
+    const int *seleccion;
+
+    const struct GeometriaCache *geometria;
+    const struct Calibracion *calibracion;
+    unsigned semilla;
+};
+
+
+extern const char *nombresFormatos[ NUM_FORMATOS ];
+
+
+/* Prototipos de las funciones a emplear */
+int buscarFormato( const char *nombre );
+FILE *abrirSalida( int formato );
+void escribirCadena( FILE *fichero, const char *cadena );
+void escribirReal( FILE *fichero, const char *formato, double valor );
+void escribirCabecera( FILE *fichero, int formato,
+    const struct Cabecera *cabecera );
+void cerrarSalida( FILE *fichero );
+
+
+#endif
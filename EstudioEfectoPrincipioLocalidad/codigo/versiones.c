@@ -0,0 +1,58 @@
+#include <string.h>
+
+#include "gather.h"
+#include "versiones.h"
+
+
+const char *nombresVersiones[ NUM_VERSIONES ] =
+{
+    [ VERSION_COMPILADA ] = "compilada",
+    [ VERSION_BASE ] = "base",
+    [ VERSION_BASE_PRECARGA ] = "base+pf",
+    [ VERSION_SSE3 ] = "sse3",
+    [ VERSION_SSE3_PRECARGA ] = "sse3+pf",
+    [ VERSION_AVX2 ] = "avx2",
+    [ VERSION_AVX2_PRECARGA ] = "avx2+pf",
+    [ VERSION_AVX512 ] = "avx512",
+    [ VERSION_AVX512_PRECARGA ] = "avx512+pf"
+};
+
+
+int buscarVersion( const char *nombre )
+{
+    // Contador
+    int i;
+
+
+    for( i = 0; i < NUM_VERSIONES; i++ )
+    {
+        if( strcmp( nombresVersiones[ i ], nombre ) == 0 )
+        {
+            return( i );
+        }
+    }
+
+    return( -1 );
+}
+
+
+int versionDisponible( int version )
+{
+    switch( version )
+    {
+        case VERSION_SSE3:
+        case VERSION_SSE3_PRECARGA:
+            return( __builtin_cpu_supports( "sse3" ) );
+
+        case VERSION_AVX2:
+        case VERSION_AVX2_PRECARGA:
+            return( disponibleAVX2() );
+
+        case VERSION_AVX512:
+        case VERSION_AVX512_PRECARGA:
+            return( disponibleAVX512() );
+
+        default:
+            return( 1 );
+    }
+}
@@ -0,0 +1,71 @@
+#ifndef VERSIONES_H
+#define VERSIONES_H
+
+
+/* Versiones de los bucles originales compiladas en el mismo ejecutable; cada
+   casilla de la matriz de pruebas.txt (conjunto de instrucciones, con y sin
+   -fprefetch-loop-arrays) es una copia del bucle con sus propios atributos */
+enum Version
+{
+    VERSION_COMPILADA,          // Opciones de la línea de compilación
+    VERSION_BASE,               // x86-64 sin SSE3
+    VERSION_BASE_PRECARGA,
+    VERSION_SSE3,
+    VERSION_SSE3_PRECARGA,
+    VERSION_AVX2,
+    VERSION_AVX2_PRECARGA,
+    VERSION_AVX512,
+    VERSION_AVX512_PRECARGA,
+    NUM_VERSIONES
+};
+
+
+/* Atributos de cada versión */
+#define SIN_PRECARGA optimize( "no-prefetch-loop-arrays" )
+#define CON_PRECARGA optimize( "prefetch-loop-arrays" )
+
+#define ATRIBUTOS_BASE __attribute__(( target( "no-sse3" ), SIN_PRECARGA ))
+#define ATRIBUTOS_BASE_PRECARGA \
+    __attribute__(( target( "no-sse3" ), CON_PRECARGA ))
+#define ATRIBUTOS_SSE3 __attribute__(( target( "sse3" ), SIN_PRECARGA ))
+#define ATRIBUTOS_SSE3_PRECARGA \
+    __attribute__(( target( "sse3" ), CON_PRECARGA ))
+#define ATRIBUTOS_AVX2 __attribute__(( target( "avx2" ), SIN_PRECARGA ))
+#define ATRIBUTOS_AVX2_PRECARGA \
+    __attribute__(( target( "avx2" ), CON_PRECARGA ))
+#define ATRIBUTOS_AVX512 __attribute__(( target( "avx512f" ), SIN_PRECARGA ))
+#define ATRIBUTOS_AVX512_PRECARGA \
+    __attribute__(( target( "avx512f" ), CON_PRECARGA ))
+
+
+/* Instancia el bucle NUCLEO( nombre, atributos, ... ) una vez por versión,
+   y construye la tabla de las instancias en el orden de enum Version */
+#define VERSIONES( NUCLEO, NOMBRE, ... ) \
+    NUCLEO( NOMBRE##Compilado, , ##__VA_ARGS__ ) \
+    NUCLEO( NOMBRE##Base, ATRIBUTOS_BASE, ##__VA_ARGS__ ) \
+    NUCLEO( NOMBRE##BasePf, ATRIBUTOS_BASE_PRECARGA, ##__VA_ARGS__ ) \
+    NUCLEO( NOMBRE##Sse3, ATRIBUTOS_SSE3, ##__VA_ARGS__ ) \
+    NUCLEO( NOMBRE##Sse3Pf, ATRIBUTOS_SSE3_PRECARGA, ##__VA_ARGS__ ) \
+    NUCLEO( NOMBRE##Avx2, ATRIBUTOS_AVX2, ##__VA_ARGS__ ) \
+    NUCLEO( NOMBRE##Avx2Pf, ATRIBUTOS_AVX2_PRECARGA, ##__VA_ARGS__ ) \
+    NUCLEO( NOMBRE##Avx512, ATRIBUTOS_AVX512, ##__VA_ARGS__ ) \
+    NUCLEO( NOMBRE##Avx512Pf, ATRIBUTOS_AVX512_PRECARGA, ##__VA_ARGS__ ) \
+    \
+    static void ( * const NOMBRE##Versiones[ NUM_VERSIONES ] )( \
+        const struct Medida *, double * ) = \
+    { \
+        NOMBRE##Compilado, NOMBRE##Base, NOMBRE##BasePf, NOMBRE##Sse3, \
+        NOMBRE##Sse3Pf, NOMBRE##Avx2, NOMBRE##Avx2Pf, NOMBRE##Avx512, \
+        NOMBRE##Avx512Pf \
+    };
+
+
+extern const char *nombresVersiones[ NUM_VERSIONES ];
+
+
+/* Prototipos de las funciones a emplear */
+int buscarVersion( const char *nombre );
+int versionDisponible( int version );
+
+
+#endif